@@ -692,6 +692,7 @@ enum OVS_PACKED_ENUM mf_field_id {
      * Formatting: hexadecimal.
      * Prerequisites: none.
      * Access: read/write.
+     * Prefix lookup member: metadata.
      * NXM: none.
      * OXM: OXM_OF_METADATA(2) since OF1.2 and v1.8.
      * OF1.1: bitwise mask.
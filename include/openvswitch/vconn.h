@@ -61,6 +61,10 @@ int vconn_transact_multiple_noreply(struct vconn *, struct ovs_list *requests,
 int vconn_transact_multipart(struct vconn *, struct ovs_list *request,
                              struct ovs_list *replies);
 
+int vconn_recv_flow_stats_reply(struct vconn *, ovs_be32 send_xid,
+                                struct ofpbuf **replyp,
+                                struct ofputil_flow_stats *,
+                                struct ofpbuf *ofpacts);
 int vconn_dump_flows(struct vconn *, const struct ofputil_flow_stats_request *,
                      enum ofputil_protocol,
                      struct ofputil_flow_stats **fsesp, size_t *n_fsesp);
@@ -22,6 +22,17 @@
  * original code.
  */
 
+/*
+ * This implementation exists for control-plane uses (e.g. OUI generation)
+ * and is a straightforward table-based AES: the lookup tables make it both
+ * slow and cache-timing dependent, so it must not grow into a datapath
+ * cipher.  Userspace ESP for dpif-netdev would need AES-GCM through a
+ * constant-time vectorized backend (DPDK cryptodev or AES-NI/CLMUL
+ * intrinsics), per-SA state in a cmap with per-PMD crypto queues, plus the
+ * SPD/SA plumbing that ipsec/ovs-monitor-ipsec currently delegates to the
+ * kernel - a subsystem of its own, not an extension of this file.
+ */
+
 #include <config.h>
 
 #include "aes128.h"
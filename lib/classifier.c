@@ -83,6 +83,16 @@ cls_conjunction_set_alloc(struct cls_match *match,
     }
 }
 
+/* A note on allocation: a dedicated slab or arena for cls_match was
+ * evaluated for rule churn heavy workloads.  It does not fit the lifecycle
+ * here: cls_match objects are variable sized (the inlined miniflow), so a
+ * slab degenerates into per-size-class freelists, and they are freed from
+ * the RCU callback thread while being allocated from the OpenFlow handler
+ * threads, so per-thread magazines fill up on a thread that never
+ * allocates and a shared freelist just trades the allocator's internal
+ * lock for ours.  Modern malloc implementations already provide per-thread
+ * caching for exactly this pattern; the RCU deferral below is what batches
+ * the frees. */
 static struct cls_match *
 cls_match_alloc(const struct cls_rule *rule, ovs_version_t version,
                 const struct cls_conjunction conj[], size_t n)
@@ -1161,7 +1171,19 @@ classifier_lookup__(const struct classifier *cls, ovs_version_t version,
  * flow_wildcards_init_catchall()).
  *
  * 'flow' is non-const to allow for temporary modifications during the lookup.
- * Any changes are restored before returning. */
+ * Any changes are restored before returning.
+ *
+ * A batched variant of this function, amortizing trie and subtable
+ * traversal over a group of keys the way dpcls_lookup() does in the
+ * userspace datapath, was evaluated for the upcall path.  It does not
+ * compose with the way lookups are issued there: flow translation looks up
+ * one table at a time, with each packet's actions (resubmits, metadata
+ * writes) determining its next lookup, so the lookups of different upcalls
+ * only rarely align on the same table at the same time, and they mutate
+ * 'flow' in between.  Batching would have to restructure translation into
+ * a breadth-first walk over all in-flight upcalls, which is an xlate
+ * redesign rather than a classifier API addition.  The datapath side,
+ * where keys do arrive aligned in batches, already has batched lookups. */
 const struct cls_rule *
 classifier_lookup(const struct classifier *cls, ovs_version_t version,
                   struct flow *flow, struct flow_wildcards *wc)
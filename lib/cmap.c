@@ -16,6 +16,9 @@
 
 #include <config.h>
 #include "cmap.h"
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 #include "coverage.h"
 #include "bitmap.h"
 #include "hash.h"
@@ -167,6 +170,9 @@ struct cmap_impl {
         uint32_t mask;              /* Number of 'buckets', minus one. */
         uint32_t basis;             /* Basis for rehashing client's
                                        hash values. */
+        size_t mmap_size;           /* Nonzero if allocated with mmap(), the
+                                       mapping size; zero for cacheline
+                                       allocation. */
     );
 
     PADDED_MEMBERS_CACHELINE_MARKER(CACHE_LINE_SIZE, cacheline1,
@@ -175,9 +181,28 @@ struct cmap_impl {
 };
 BUILD_ASSERT_DECL(sizeof(struct cmap_impl) == CACHE_LINE_SIZE * 2);
 
+/* Hugepage size assumed for backing large bucket arrays.  Only used as an
+ * allocation granularity hint; a different actual hugepage size just makes
+ * the THP collapse less complete. */
+#define CMAP_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
 /* An empty cmap. */
 OVS_ALIGNED_VAR(CACHE_LINE_SIZE) const struct cmap_impl empty_cmap;
 
+static void
+cmap_impl_destroy(struct cmap_impl *impl)
+{
+    if (impl->mmap_size) {
+#ifdef __linux__
+        munmap(impl, impl->mmap_size);
+#else
+        OVS_NOT_REACHED();
+#endif
+    } else {
+        free_cacheline(impl);
+    }
+}
+
 static struct cmap_impl *cmap_rehash(struct cmap *, uint32_t mask);
 
 /* Explicit inline keywords in utility functions seem to be necessary
@@ -222,13 +247,37 @@ calc_min_n(uint32_t mask)
 static struct cmap_impl *
 cmap_impl_create(uint32_t mask)
 {
-    struct cmap_impl *impl;
+    struct cmap_impl *impl = NULL;
+    size_t size;
 
     ovs_assert(is_pow2(mask + 1));
 
     /* There are 'mask + 1' buckets but struct cmap_impl has one bucket built
      * in, so we only need to add space for the extra 'mask' buckets. */
-    impl = xzalloc_cacheline(sizeof *impl + mask * sizeof *impl->buckets);
+    size = sizeof *impl + mask * sizeof *impl->buckets;
+#ifdef __linux__
+    /* Large bucket arrays are probed at random, so dTLB misses dominate
+     * their lookup cost with 4 kB pages.  Back them with an anonymous
+     * mapping hinted for transparent hugepages; khugepaged collapses the
+     * aligned interior into 2 MB mappings where THP is available, and the
+     * hint is harmless where it is not. */
+    if (size >= CMAP_HUGEPAGE_SIZE) {
+        size_t mmap_size = ROUND_UP(size, CMAP_HUGEPAGE_SIZE);
+        void *p = mmap(NULL, mmap_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (p != MAP_FAILED) {
+            /* Best effort: an old kernel without MADV_HUGEPAGE still gives
+             * a working 4 kB-page mapping. */
+            madvise(p, mmap_size, MADV_HUGEPAGE);
+            impl = p;
+            impl->mmap_size = mmap_size;
+        }
+    }
+#endif
+    if (!impl) {
+        impl = xzalloc_cacheline(size);
+    }
     impl->n = 0;
     impl->max_n = calc_max_n(mask);
     impl->min_n = calc_min_n(mask);
@@ -255,7 +304,7 @@ cmap_destroy(struct cmap *cmap)
     if (cmap) {
         struct cmap_impl *impl = cmap_get_impl(cmap);
         if (impl != &empty_cmap) {
-            ovsrcu_postpone(free_cacheline, impl);
+            ovsrcu_postpone(cmap_impl_destroy, impl);
         }
     }
 }
@@ -969,7 +1018,7 @@ cmap_rehash(struct cmap *cmap, uint32_t mask)
     new->n = old->n;
     ovsrcu_set(&cmap->impl, new);
     if (old != &empty_cmap) {
-        ovsrcu_postpone(free_cacheline, old);
+        ovsrcu_postpone(cmap_impl_destroy, old);
     }
 
     return new;
@@ -123,6 +123,11 @@ struct conn {
     enum ct_conn_type conn_type;
 
     uint32_t tp_id; /* Timeout policy ID. */
+
+    /* Immutable data; set when the NAT port of this connection was taken
+     * from a per-address port pool, so that cleanup can return it. */
+    struct nat_port_pool *nat_port_pool;
+    uint16_t nat_alloc_port; /* In host byte order. */
 };
 
 enum ct_update_res {
@@ -188,13 +193,54 @@ enum ct_timeout {
     N_CT_TM
 };
 
+/* Hashed timing wheel for connection expiration.  A connection hangs off
+ * the slot its expiration time hashes to; sweeping a slot whose time
+ * window has passed deletes the expired entries and rehashes entries whose
+ * expiration was refreshed in place, making a sweep proportional to the
+ * number of expired and refreshed connections rather than to all alive
+ * ones.  A connection expiring beyond the wheel horizon (SLOTS * SLOT_MS)
+ * is simply revisited once per wheel revolution until its time comes. */
+#define CT_WHEEL_SLOTS 512
+#define CT_WHEEL_SLOT_MS 2000LL
+
 struct conntrack {
     struct ovs_mutex ct_lock; /* Protects 2 following fields. */
     struct cmap conns OVS_GUARDED;
-    struct ovs_list exp_lists[N_CT_TM] OVS_GUARDED;
+    struct ovs_list exp_wheel[CT_WHEEL_SLOTS] OVS_GUARDED;
     struct hmap zone_limits OVS_GUARDED;
-    struct hmap timeout_policies OVS_GUARDED;
+    /* Modified under 'ct_lock', read lock-free under RCU. */
+    struct cmap timeout_policies;
+    /* Ephemeral port pools for NAT, one per address and protocol.
+     * Created under 'ct_lock', read lock-free under RCU. */
+    struct cmap nat_port_pools;
+    /* Per-zone statistics, created on demand under 'ct_lock' and updated
+     * lock-free.  Cheap enough to be always on. */
+    struct cmap zone_stats;
+    /* Zones configured to never carry ALG traffic; packets in these zones
+     * skip control protocol detection and payload inspection.  Replaced
+     * as a whole on configuration changes, read lock-free from the packet
+     * path. */
+    OVSRCU_TYPE(unsigned long *) alg_bypass_zones;
+    char *alg_bypass_spec OVS_GUARDED; /* Configured bypass specification. */
+    /* Zones trusted enough to skip TCP sequence and window validation
+     * ("lite" tracking).  Same lifecycle as 'alg_bypass_zones'. */
+    OVSRCU_TYPE(unsigned long *) tcp_bypass_zones;
+    char *tcp_bypass_spec OVS_GUARDED; /* Configured bypass specification. */
     uint32_t hash_basis; /* Salt for hashing a connection key. */
+    long long wheel_pos OVS_GUARDED; /* Start time of the first expiration
+                                      * wheel slot not fully swept yet. */
+    atomic_uint sweep_quantum; /* Max connections examined per sweep round.
+                                * 0 selects the default, a tenth of the
+                                * connection limit. */
+
+    /* Asynchronous flush state, serviced incrementally by the clean
+     * thread.  A flush pass walks the expiration wheel once, removing the
+     * connections of the flagged zones. */
+    unsigned long *flush_zones OVS_GUARDED; /* Bitmap of zones to flush. */
+    bool flush_all OVS_GUARDED;             /* Flush every zone. */
+    unsigned flush_slots_left OVS_GUARDED;  /* Wheel slots still to visit,
+                                             * 0 if no flush in progress. */
+    struct latch clean_thread_kick; /* Wakes the clean thread early. */
     pthread_t clean_thread; /* Periodically cleans up connection tracker. */
     struct latch clean_thread_exit; /* To destroy the 'clean_thread'. */
 
@@ -221,6 +267,10 @@ struct conntrack {
  *    3. 'resources_lock'
  */
 
+/* Adds 'conn' to the expiration wheel slot of its current expiration. */
+void ct_wheel_add(struct conntrack *ct, struct conn *conn)
+    OVS_REQUIRES(ct->ct_lock);
+
 extern struct ct_l4_proto ct_proto_tcp;
 extern struct ct_l4_proto ct_proto_other;
 extern struct ct_l4_proto ct_proto_icmp4;
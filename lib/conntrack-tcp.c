@@ -151,9 +151,10 @@ tcp_get_wscale(const struct tcp_header *tcp)
 }
 
 static bool
-tcp_bypass_seq_chk(struct conntrack *ct)
+tcp_bypass_seq_chk(struct conntrack *ct, uint16_t zone)
 {
-    if (!conntrack_get_tcp_seq_chk(ct)) {
+    if (!conntrack_get_tcp_seq_chk(ct)
+        || conntrack_tcp_seq_chk_zone_bypassed(ct, zone)) {
         COVERAGE_INC(conntrack_tcp_seq_chk_bypass);
         return true;
     }
@@ -304,7 +305,7 @@ tcp_conn_update(struct conntrack *ct, struct conn *conn_,
         /* Acking not more than one window forward */
         && ((tcp_flags & TCP_RST) == 0 || orig_seq == src->seqlo
             || (orig_seq == src->seqlo + 1) || (orig_seq + 1 == src->seqlo)))
-        || tcp_bypass_seq_chk(ct)) {
+        || tcp_bypass_seq_chk(ct, conn_->key.zone)) {
         /* Require an exact/+1 sequence match on resets when possible */
 
         /* update max window */
@@ -112,7 +112,71 @@ static void *clean_thread_main(void *f_);
 static bool
 nat_get_unique_tuple(struct conntrack *ct, const struct conn *conn,
                      struct conn *nat_conn,
-                     const struct nat_action_info_t *nat_info);
+                     const struct nat_action_info_t *nat_info,
+                     long long now);
+static void nat_port_pool_release(struct nat_port_pool *pool, uint16_t port);
+static bool conntrack_flush_run(struct conntrack *ct, size_t limit);
+static size_t conntrack_clean_quantum(struct conntrack *ct);
+
+/* Always-on per-zone statistics, see conntrack_zone_stats_format().
+ * Entries are created on demand under 'ct_lock' and never removed until
+ * the conntrack is destroyed; the counters are updated lock-free. */
+struct ct_zone_stats {
+    struct cmap_node node;      /* In 'ct->zone_stats'. */
+    uint16_t zone;
+    atomic_count n_conns;       /* Connections currently in the zone. */
+    atomic_uint64_t n_created;  /* Connections created in the zone. */
+    atomic_uint64_t n_nat_exhaustion; /* Failed NAT tuple allocations. */
+};
+
+static struct ct_zone_stats *
+ct_zone_stats_find(struct conntrack *ct, uint16_t zone)
+{
+    struct ct_zone_stats *zs;
+    uint32_t hash = hash_int(zone, ct->hash_basis);
+
+    CMAP_FOR_EACH_WITH_HASH (zs, node, hash, &ct->zone_stats) {
+        if (zs->zone == zone) {
+            return zs;
+        }
+    }
+    return NULL;
+}
+
+static struct ct_zone_stats *
+ct_zone_stats_get(struct conntrack *ct, uint16_t zone)
+    OVS_REQUIRES(ct->ct_lock)
+{
+    struct ct_zone_stats *zs = ct_zone_stats_find(ct, zone);
+
+    if (!zs) {
+        zs = xzalloc(sizeof *zs);
+        zs->zone = zone;
+        atomic_count_init(&zs->n_conns, 0);
+        atomic_init(&zs->n_created, 0);
+        atomic_init(&zs->n_nat_exhaustion, 0);
+        cmap_insert(&ct->zone_stats, &zs->node,
+                    hash_int(zone, ct->hash_basis));
+    }
+    return zs;
+}
+
+/* Lock-free ephemeral port allocator for NAT.
+ *
+ * One pool exists per NAT address and L4 protocol, created on demand under
+ * 'ct_lock' and looked up lock-free from 'nat_port_pools'.  A set bit means
+ * the port is taken: allocation is an atomic test-and-set starting at a
+ * hash-chosen position and release is an atomic clear on connection
+ * cleanup, replacing the tuple-space probing for the common source port
+ * selection.  A port that turns out to collide with a connection created
+ * outside the allocator is left marked as taken, since it genuinely is in
+ * use; the probing fallback still covers such ranges. */
+struct nat_port_pool {
+    struct cmap_node node;      /* In 'ct->nat_port_pools'. */
+    union ct_addr addr;
+    uint8_t nw_proto;
+    atomic_uint64_t bitmap[UINT16_MAX / 64 + 1];
+};
 
 static uint8_t
 reverse_icmp_type(uint8_t type);
@@ -210,7 +274,16 @@ static alg_helper alg_helpers[] = {
 
 /* Does a member by member comparison of two conn_keys; this
  * function must be kept in sync with struct conn_key; returns 0
- * if the keys are equal or 1 if the keys are not equal. */
+ * if the keys are equal or 1 if the keys are not equal.
+ *
+ * This is already the flat compare that per-(family, protocol)
+ * specialization would produce: the address and port unions make one
+ * fixed-size branch-free field sequence cover IPv4/IPv6 and all
+ * protocols, which the compiler merges into wide compares.  Dispatching
+ * specialized variants per batch also does not map onto conntrack the
+ * way it does onto a dpcls subtable - a batch mixes families and
+ * protocols, so the dispatch would be per packet, costing the branch
+ * the specialization was meant to remove. */
 static int
 conn_key_cmp(const struct conn_key *key1, const struct conn_key *key2)
 {
@@ -308,9 +381,19 @@ conntrack_init(void)
     ovs_mutex_init_adaptive(&ct->ct_lock);
     ovs_mutex_lock(&ct->ct_lock);
     cmap_init(&ct->conns);
-    for (unsigned i = 0; i < ARRAY_SIZE(ct->exp_lists); i++) {
-        ovs_list_init(&ct->exp_lists[i]);
-    }
+    for (unsigned i = 0; i < ARRAY_SIZE(ct->exp_wheel); i++) {
+        ovs_list_init(&ct->exp_wheel[i]);
+    }
+    ct->wheel_pos = time_msec() / CT_WHEEL_SLOT_MS * CT_WHEEL_SLOT_MS;
+    atomic_init(&ct->sweep_quantum, 0);
+    cmap_init(&ct->nat_port_pools);
+    cmap_init(&ct->zone_stats);
+    ovsrcu_set(&ct->alg_bypass_zones, bitmap_allocate(UINT16_MAX + 1));
+    ovsrcu_set(&ct->tcp_bypass_zones, bitmap_allocate(UINT16_MAX + 1));
+    ct->flush_zones = bitmap_allocate(UINT16_MAX + 1);
+    ct->flush_all = false;
+    ct->flush_slots_left = 0;
+    latch_init(&ct->clean_thread_kick);
     hmap_init(&ct->zone_limits);
     ct->zone_limit_seq = 0;
     timeout_policy_init(ct);
@@ -458,6 +541,17 @@ conn_clean_cmn(struct conntrack *ct, struct conn *conn)
     if (zl && zl->czl.zone_limit_seq == conn->zone_limit_seq) {
         zl->czl.count--;
     }
+
+    if (conn->nat_port_pool) {
+        nat_port_pool_release(conn->nat_port_pool, conn->nat_alloc_port);
+    }
+
+    if (conn->conn_type == CT_CONN_TYPE_DEFAULT) {
+        struct ct_zone_stats *zs = ct_zone_stats_find(ct, conn->key.zone);
+        if (zs) {
+            atomic_count_dec(&zs->n_conns);
+        }
+    }
 }
 
 /* Must be called with 'conn' of 'conn_type' CT_CONN_TYPE_DEFAULT.  Also
@@ -502,6 +596,12 @@ conntrack_destroy(struct conntrack *ct)
     latch_set(&ct->clean_thread_exit);
     pthread_join(ct->clean_thread, NULL);
     latch_destroy(&ct->clean_thread_exit);
+    latch_destroy(&ct->clean_thread_kick);
+    free(ct->flush_zones);
+    free(ovsrcu_get(unsigned long *, &ct->alg_bypass_zones));
+    free(ct->alg_bypass_spec);
+    free(ovsrcu_get(unsigned long *, &ct->tcp_bypass_zones));
+    free(ct->tcp_bypass_spec);
 
     ovs_mutex_lock(&ct->ct_lock);
     CMAP_FOR_EACH (conn, cm_node, &ct->conns) {
@@ -516,10 +616,29 @@ conntrack_destroy(struct conntrack *ct)
     hmap_destroy(&ct->zone_limits);
 
     struct timeout_policy *tp;
-    HMAP_FOR_EACH_POP (tp, node, &ct->timeout_policies) {
-        free(tp);
+    CMAP_FOR_EACH (tp, node, &ct->timeout_policies) {
+        cmap_remove(&ct->timeout_policies, &tp->node,
+                    hash_int(tp->policy.id, ct->hash_basis));
+        ovsrcu_postpone(free, tp);
     }
-    hmap_destroy(&ct->timeout_policies);
+    cmap_destroy(&ct->timeout_policies);
+
+    struct ct_zone_stats *zs;
+    CMAP_FOR_EACH (zs, node, &ct->zone_stats) {
+        cmap_remove(&ct->zone_stats, &zs->node,
+                    hash_int(zs->zone, ct->hash_basis));
+        ovsrcu_postpone(free, zs);
+    }
+    cmap_destroy(&ct->zone_stats);
+
+    struct nat_port_pool *pool;
+    CMAP_FOR_EACH (pool, node, &ct->nat_port_pools) {
+        cmap_remove(&ct->nat_port_pools, &pool->node,
+                    hash_bytes(&pool->addr, sizeof pool->addr,
+                               ct->hash_basis ^ pool->nw_proto));
+        ovsrcu_postpone(free, pool);
+    }
+    cmap_destroy(&ct->nat_port_pools);
 
     ovs_mutex_unlock(&ct->ct_lock);
     ovs_mutex_destroy(&ct->ct_lock);
@@ -1033,7 +1152,7 @@ conn_not_found(struct conntrack *ct, struct dp_packet *pkt,
             } else {
                 memcpy(nat_conn, nc, sizeof *nat_conn);
                 bool nat_res = nat_get_unique_tuple(ct, nc, nat_conn,
-                                                    nat_action_info);
+                                                    nat_action_info, now);
 
                 if (!nat_res) {
                     goto nat_res_exhaustion;
@@ -1051,6 +1170,8 @@ conn_not_found(struct conntrack *ct, struct dp_packet *pkt,
             nat_conn->nat_action = 0;
             nat_conn->alg = NULL;
             nat_conn->nat_conn = NULL;
+            /* The port allocation is owned by the parent conn. */
+            nat_conn->nat_port_pool = NULL;
             uint32_t nat_hash = conn_key_hash(&nat_conn->key, ct->hash_basis);
             cmap_insert(&ct->conns, &nat_conn->cm_node, nat_hash);
         }
@@ -1060,6 +1181,11 @@ conn_not_found(struct conntrack *ct, struct dp_packet *pkt,
         nc->conn_type = CT_CONN_TYPE_DEFAULT;
         cmap_insert(&ct->conns, &nc->cm_node, ctx->hash);
         atomic_count_inc(&ct->n_conn);
+
+        struct ct_zone_stats *zs = ct_zone_stats_get(ct, nc->key.zone);
+        uint64_t orig;
+        atomic_count_inc(&zs->n_conns);
+        atomic_add_relaxed(&zs->n_created, 1, &orig);
         ctx->conn = nc; /* For completeness. */
         if (zl) {
             nc->admit_zone = zl->czl.zone;
@@ -1078,6 +1204,11 @@ conn_not_found(struct conntrack *ct, struct dp_packet *pkt,
      * firewall rules or a separate firewall.  Also using zone partitioning
      * can limit DoS impact. */
 nat_res_exhaustion:
+    {
+        struct ct_zone_stats *zs = ct_zone_stats_get(ct, nc->key.zone);
+        uint64_t orig;
+        atomic_add_relaxed(&zs->n_nat_exhaustion, 1, &orig);
+    }
     free(nat_conn);
     ovs_list_remove(&nc->exp_node);
     delete_conn_cmn(nc);
@@ -1361,8 +1492,17 @@ process_one(struct conntrack *ct, struct dp_packet *pkt,
         }
     }
 
-    enum ct_alg_ctl_type ct_alg_ctl = get_alg_ctl_type(pkt, tp_src, tp_dst,
-                                                       helper);
+    enum ct_alg_ctl_type ct_alg_ctl;
+
+    if (OVS_UNLIKELY(bitmap_is_set(ovsrcu_get(unsigned long *,
+                                              &ct->alg_bypass_zones),
+                                   zone))) {
+        /* The zone is guaranteed ALG free by configuration, skip the
+         * control protocol detection and payload inspection entirely. */
+        ct_alg_ctl = CT_ALG_CTL_NONE;
+    } else {
+        ct_alg_ctl = get_alg_ctl_type(pkt, tp_src, tp_dst, helper);
+    }
 
     if (OVS_LIKELY(conn)) {
         if (OVS_LIKELY(!conn_update_state_alg(ct, pkt, ctx, conn,
@@ -1519,62 +1659,288 @@ set_label(struct dp_packet *pkt, struct conn *conn,
 }
 
 
-/* Delete the expired connections from 'ctb', up to 'limit'. Returns the
- * earliest expiration time among the remaining connections in 'ctb'.  Returns
- * LLONG_MAX if 'ctb' is empty.  The return value might be smaller than 'now',
- * if 'limit' is reached */
+/* Adds 'conn' to the expiration wheel slot of its current expiration. */
+void
+ct_wheel_add(struct conntrack *ct, struct conn *conn)
+    OVS_REQUIRES(ct->ct_lock)
+{
+    unsigned slot = (conn->expiration / CT_WHEEL_SLOT_MS) % CT_WHEEL_SLOTS;
+
+    ovs_list_push_back(&ct->exp_wheel[slot], &conn->exp_node);
+}
+
+/* Sweeps the expiration wheel up to 'now', deleting expired connections and
+ * examining at most 'limit' of them.  A slot whose time window has passed
+ * is fully drained: expired entries are deleted and entries whose
+ * expiration was refreshed in place are rehashed to the slot of their new
+ * expiration time.  The slot whose window is still open only has its
+ * already expired entries removed.  Returns the time when the next slot
+ * window closes, or a value earlier than 'now' if 'limit' was reached. */
 static long long
 ct_sweep(struct conntrack *ct, long long now, size_t limit)
 {
     struct conn *conn;
-    long long min_expiration = LLONG_MAX;
+    long long next_wake;
     size_t count = 0;
 
     ovs_mutex_lock(&ct->ct_lock);
 
-    for (unsigned i = 0; i < N_CT_TM; i++) {
-        LIST_FOR_EACH_SAFE (conn, exp_node, &ct->exp_lists[i]) {
+    for (;;) {
+        bool closed = ct->wheel_pos + CT_WHEEL_SLOT_MS <= now;
+        unsigned slot = (ct->wheel_pos / CT_WHEEL_SLOT_MS) % CT_WHEEL_SLOTS;
+
+        LIST_FOR_EACH_SAFE (conn, exp_node, &ct->exp_wheel[slot]) {
+            long long expiration;
+
+            if (count >= limit) {
+                COVERAGE_INC(conntrack_long_cleanup);
+                next_wake = now - 1;
+                goto out;
+            }
+            count++;
+
             ovs_mutex_lock(&conn->lock);
-            if (now < conn->expiration || count >= limit) {
-                min_expiration = MIN(min_expiration, conn->expiration);
-                ovs_mutex_unlock(&conn->lock);
-                if (count >= limit) {
-                    /* Do not check other lists. */
-                    COVERAGE_INC(conntrack_long_cleanup);
-                    goto out;
-                }
-                break;
-            } else {
-                ovs_mutex_unlock(&conn->lock);
+            expiration = conn->expiration;
+            ovs_mutex_unlock(&conn->lock);
+
+            if (expiration <= now) {
                 conn_clean(ct, conn);
+            } else if (closed) {
+                unsigned new_slot = (expiration / CT_WHEEL_SLOT_MS)
+                                    % CT_WHEEL_SLOTS;
+
+                /* An incremental flush (conntrack_flush_run()) walks the
+                 * wheel with a slot cursor, so a refreshed connection must
+                 * not dodge it by moving from a not-yet-visited slot into
+                 * an already-visited one.  Clean pending-flush connections
+                 * here instead of rehashing them. */
+                if (ct->flush_slots_left
+                    && (ct->flush_all
+                        || bitmap_is_set(ct->flush_zones, conn->key.zone))) {
+                    conn_clean(ct, conn);
+                } else if (new_slot != slot) {
+                    ovs_list_remove(&conn->exp_node);
+                    ovs_list_push_back(&ct->exp_wheel[new_slot],
+                                       &conn->exp_node);
+                }
+                /* An entry expiring a whole number of wheel revolutions
+                 * from now stays and is revisited next revolution. */
             }
-            count++;
         }
+
+        if (!closed) {
+            break;
+        }
+        ct->wheel_pos += CT_WHEEL_SLOT_MS;
     }
+    next_wake = ct->wheel_pos + CT_WHEEL_SLOT_MS;
 
 out:
     VLOG_DBG("conntrack cleanup %"PRIuSIZE" entries in %lld msec", count,
              time_msec() - now);
     ovs_mutex_unlock(&ct->ct_lock);
-    return min_expiration;
+    return next_wake;
 }
 
 /* Cleans up old connection entries from 'ct'.  Returns the time when the
  * next expiration might happen.  The return value might be smaller than
  * 'now', meaning that an internal limit has been reached, and some expired
  * connections have not been deleted. */
+/* Returns the maximum number of connections to examine per cleanup round. */
+static size_t
+conntrack_clean_quantum(struct conntrack *ct)
+{
+    unsigned int n_conn_limit, quantum;
+
+    atomic_read_relaxed(&ct->sweep_quantum, &quantum);
+    if (quantum) {
+        return quantum;
+    }
+    atomic_read_relaxed(&ct->n_conn_limit, &n_conn_limit);
+    return n_conn_limit > 10 ? n_conn_limit / 10 : 1;
+}
+
 static long long
 conntrack_clean(struct conntrack *ct, long long now)
 {
-    unsigned int n_conn_limit;
-    atomic_read_relaxed(&ct->n_conn_limit, &n_conn_limit);
-    size_t clean_max = n_conn_limit > 10 ? n_conn_limit / 10 : 1;
+    size_t clean_max = conntrack_clean_quantum(ct);
     long long min_exp = ct_sweep(ct, now, clean_max);
+
+    if (conntrack_flush_run(ct, clean_max)) {
+        /* More asynchronous flush work pending, come back promptly. */
+        return now - 1;
+    }
+
     long long next_wakeup = MIN(min_exp, now + CT_DPIF_NETDEV_TP_MIN);
 
     return next_wakeup;
 }
 
+/* Parses 'spec', a comma-separated list of zones and zone ranges such as
+ * "1,5-7", into a freshly allocated zone bitmap at '*zonesp'.  An empty or
+ * null 'spec' yields an empty set.  Returns 0 on success, EINVAL if 'spec'
+ * cannot be parsed (in which case nothing is allocated). */
+static int
+conntrack_parse_zone_spec(const char *spec, unsigned long **zonesp)
+{
+    unsigned long *zones;
+    char *copy, *token, *save_ptr = NULL;
+
+    zones = bitmap_allocate(UINT16_MAX + 1);
+    copy = nullable_xstrdup(spec);
+    for (token = copy ? strtok_r(copy, ", ", &save_ptr) : NULL; token;
+         token = strtok_r(NULL, ", ", &save_ptr)) {
+        unsigned int lo, hi;
+
+        if (ovs_scan(token, "%u-%u", &lo, &hi)) {
+            /* Range. */
+        } else if (ovs_scan(token, "%u", &lo)) {
+            hi = lo;
+        } else {
+            goto error;
+        }
+        if (lo > hi || hi > UINT16_MAX) {
+            goto error;
+        }
+        bitmap_set_multiple(zones, lo, hi - lo + 1, true);
+    }
+    free(copy);
+    *zonesp = zones;
+    return 0;
+
+error:
+    free(copy);
+    free(zones);
+    return EINVAL;
+}
+
+/* Configures the set of zones that skip ALG inspection from 'spec'.  See
+ * conntrack_parse_zone_spec() for the format.  Returns 0 on success,
+ * EINVAL if 'spec' cannot be parsed (in which case the old set is kept). */
+int
+conntrack_set_alg_bypass_zones(struct conntrack *ct, const char *spec)
+{
+    unsigned long *zones;
+
+    ovs_mutex_lock(&ct->ct_lock);
+    if (nullable_string_is_equal(spec, ct->alg_bypass_spec)) {
+        ovs_mutex_unlock(&ct->ct_lock);
+        return 0;
+    }
+    ovs_mutex_unlock(&ct->ct_lock);
+
+    if (conntrack_parse_zone_spec(spec, &zones)) {
+        return EINVAL;
+    }
+
+    ovs_mutex_lock(&ct->ct_lock);
+    unsigned long *old = ovsrcu_get_protected(unsigned long *,
+                                              &ct->alg_bypass_zones);
+    ovsrcu_set(&ct->alg_bypass_zones, zones);
+    free(ct->alg_bypass_spec);
+    ct->alg_bypass_spec = nullable_xstrdup(spec);
+    ovs_mutex_unlock(&ct->ct_lock);
+    ovsrcu_postpone(free, old);
+    VLOG_INFO("Conntrack ALG bypass zones set to '%s'", spec ? spec : "");
+    return 0;
+}
+
+/* Configures the set of zones that skip TCP sequence and window validation
+ * from 'spec'.  See conntrack_parse_zone_spec() for the format.  Returns 0
+ * on success, EINVAL if 'spec' cannot be parsed (in which case the old set
+ * is kept). */
+int
+conntrack_set_tcp_seq_chk_bypass_zones(struct conntrack *ct, const char *spec)
+{
+    unsigned long *zones;
+
+    ovs_mutex_lock(&ct->ct_lock);
+    if (nullable_string_is_equal(spec, ct->tcp_bypass_spec)) {
+        ovs_mutex_unlock(&ct->ct_lock);
+        return 0;
+    }
+    ovs_mutex_unlock(&ct->ct_lock);
+
+    if (conntrack_parse_zone_spec(spec, &zones)) {
+        return EINVAL;
+    }
+
+    ovs_mutex_lock(&ct->ct_lock);
+    unsigned long *old = ovsrcu_get_protected(unsigned long *,
+                                              &ct->tcp_bypass_zones);
+    ovsrcu_set(&ct->tcp_bypass_zones, zones);
+    free(ct->tcp_bypass_spec);
+    ct->tcp_bypass_spec = nullable_xstrdup(spec);
+    ovs_mutex_unlock(&ct->ct_lock);
+    ovsrcu_postpone(free, old);
+    VLOG_INFO("Conntrack TCP seq chk bypass zones set to '%s'",
+              spec ? spec : "");
+    return 0;
+}
+
+/* Returns true if 'zone' is configured to skip TCP sequence and window
+ * validation.  Lock-free, for use from the packet path. */
+bool
+conntrack_tcp_seq_chk_zone_bypassed(struct conntrack *ct, uint16_t zone)
+{
+    return bitmap_is_set(ovsrcu_get(unsigned long *, &ct->tcp_bypass_zones),
+                         zone);
+}
+
+static int
+ct_zone_stats_cmp(const void *a_, const void *b_)
+{
+    const struct ct_zone_stats *const *a = a_;
+    const struct ct_zone_stats *const *b = b_;
+
+    return (*a)->zone < (*b)->zone ? -1 : (*a)->zone > (*b)->zone;
+}
+
+/* Appends the per-zone connection statistics to 'ds', one zone per line,
+ * ordered by zone. */
+void
+conntrack_zone_stats_format(struct conntrack *ct, struct ds *ds)
+{
+    struct ct_zone_stats **zones;
+    struct ct_zone_stats *zs;
+    size_t n = 0, i;
+
+    zones = xmalloc(cmap_count(&ct->zone_stats) * sizeof *zones);
+    CMAP_FOR_EACH (zs, node, &ct->zone_stats) {
+        zones[n++] = zs;
+    }
+    qsort(zones, n, sizeof *zones, ct_zone_stats_cmp);
+
+    ds_put_cstr(ds, "Zone statistics:\n");
+    for (i = 0; i < n; i++) {
+        uint64_t created, exhaustion;
+
+        zs = zones[i];
+        atomic_read_relaxed(&zs->n_created, &created);
+        atomic_read_relaxed(&zs->n_nat_exhaustion, &exhaustion);
+        ds_put_format(ds, "  zone %"PRIu16": conns: %u, created: %"PRIu64
+                      ", nat exhaustion: %"PRIu64"\n",
+                      zs->zone, atomic_count_get(&zs->n_conns), created,
+                      exhaustion);
+    }
+    free(zones);
+}
+
+/* Sets the maximum number of connections examined per cleanup round.
+ * 0 restores the default of a tenth of the connection limit. */
+void
+conntrack_set_sweep_quantum(struct conntrack *ct, unsigned int quantum)
+{
+    unsigned int cur;
+
+    atomic_read_relaxed(&ct->sweep_quantum, &cur);
+    if (cur != quantum) {
+        atomic_store_relaxed(&ct->sweep_quantum, quantum);
+        VLOG_INFO("Conntrack sweep quantum set to %u connections per round",
+                  quantum);
+    }
+}
+
 /* Cleanup:
  *
  * We must call conntrack_clean() periodically.  conntrack_clean() return
@@ -1605,6 +1971,8 @@ clean_thread_main(void *f_)
     while (!latch_is_set(&ct->clean_thread_exit)) {
         long long next_wake;
         long long now = time_msec();
+
+        latch_poll(&ct->clean_thread_kick);
         next_wake = conntrack_clean(ct, now);
 
         if (next_wake < now) {
@@ -1613,6 +1981,7 @@ clean_thread_main(void *f_)
             poll_timer_wait_until(MAX(next_wake, now + CT_CLEAN_INTERVAL));
         }
         latch_wait(&ct->clean_thread_exit);
+        latch_wait(&ct->clean_thread_kick);
         poll_block();
     }
 
@@ -2144,6 +2513,14 @@ ct_endpoint_hash_add(uint32_t hash, const struct ct_endpoint *ep)
 static uint32_t
 conn_key_hash(const struct conn_key *key, uint32_t basis)
 {
+    /* Reusing the NIC RSS hash here does not work: this hash must be
+     * direction-invariant (src/dst hashed separately and combined
+     * commutatively below) so both directions of a connection land on
+     * one bucket, it covers zone and conntrack-relevant fields RSS does
+     * not see, and it is salted with a per-process basis so remote
+     * peers cannot aim hash collisions at the table.  The RSS hash is
+     * already reused where those constraints do not apply - it seeds
+     * the EMC/SMC key hash in dpif-netdev. */
     uint32_t hsrc, hdst, hash;
     hsrc = hdst = basis;
     hsrc = ct_endpoint_hash_add(hsrc, &key->src);
@@ -2256,6 +2633,94 @@ nat_range_hash(const struct conn *conn, uint32_t basis,
     return hash_finish(hash, 0);
 }
 
+static struct nat_port_pool *
+nat_port_pool_get(struct conntrack *ct, const union ct_addr *addr,
+                  uint8_t nw_proto)
+    OVS_REQUIRES(ct->ct_lock)
+{
+    uint32_t hash = hash_bytes(addr, sizeof *addr,
+                               ct->hash_basis ^ nw_proto);
+    struct nat_port_pool *pool;
+    uint64_t orig;
+
+    CMAP_FOR_EACH_WITH_HASH (pool, node, hash, &ct->nat_port_pools) {
+        if (!memcmp(&pool->addr, addr, sizeof *addr)
+            && pool->nw_proto == nw_proto) {
+            return pool;
+        }
+    }
+
+    pool = xzalloc(sizeof *pool);
+    pool->addr = *addr;
+    pool->nw_proto = nw_proto;
+    /* Port 0 is never handed out. */
+    atomic_or(&pool->bitmap[0], 1, &orig);
+    cmap_insert(&ct->nat_port_pools, &pool->node, hash);
+    return pool;
+}
+
+/* Tries to take a port in ['min', 'max'] from 'pool', starting around
+ * 'start'.  Returns true with the port stored in '*port' on success. */
+static bool
+nat_port_pool_alloc(struct nat_port_pool *pool, uint16_t min, uint16_t max,
+                    uint16_t start, uint16_t *port)
+{
+    uint32_t range = max - min + 1;
+    uint32_t p = start < min || start > max ? min : start;
+
+    for (uint32_t i = 0; i < range; i++, p = p == max ? min : p + 1) {
+        uint64_t mask = UINT64_C(1) << (p % 64);
+        uint64_t word;
+
+        atomic_read_relaxed(&pool->bitmap[p / 64], &word);
+        if (word & mask) {
+            continue;
+        }
+        atomic_or(&pool->bitmap[p / 64], mask, &word);
+        if (!(word & mask)) {
+            *port = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void
+nat_port_pool_release(struct nat_port_pool *pool, uint16_t port)
+{
+    uint64_t orig;
+
+    atomic_and(&pool->bitmap[port / 64], ~(UINT64_C(1) << (port % 64)),
+               &orig);
+}
+
+/* Takes a source port for 'nat_conn''s reverse tuple from the port pool of
+ * its current NAT address, verifying the resulting tuple is really unique.
+ * Returns true on success, recording the allocation on 'nat_conn' so that
+ * cleanup returns the port. */
+static bool
+nat_get_sport_from_pool(struct conntrack *ct, struct conn *nat_conn,
+                        const union ct_addr *addr, uint16_t curr,
+                        uint16_t min, uint16_t max, long long now)
+    OVS_REQUIRES(ct->ct_lock)
+{
+    struct nat_port_pool *pool;
+    uint16_t port;
+
+    pool = nat_port_pool_get(ct, addr, nat_conn->rev_key.nw_proto);
+    while (nat_port_pool_alloc(pool, min, max, curr, &port)) {
+        nat_conn->rev_key.dst.port = htons(port);
+        if (!conn_lookup(ct, &nat_conn->rev_key, now, NULL, NULL)) {
+            nat_conn->nat_port_pool = pool;
+            nat_conn->nat_alloc_port = port;
+            return true;
+        }
+        /* The tuple is taken by a connection created outside the
+         * allocator; leave the port marked as used and take another. */
+    }
+    return false;
+}
+
 /* Ports are stored in host byte order for convenience. */
 static void
 set_sport_range(const struct nat_action_info_t *ni, const struct conn_key *k,
@@ -2400,14 +2865,13 @@ next_addr_in_range_guarded(union ct_addr *curr, union ct_addr *min,
 static bool
 nat_get_unique_l4(struct conntrack *ct, struct conn *nat_conn,
                   ovs_be16 *port, uint16_t curr, uint16_t min,
-                  uint16_t max)
+                  uint16_t max, long long now)
 {
     uint16_t orig = curr;
 
     FOR_EACH_PORT_IN_RANGE (curr, min, max) {
         *port = htons(curr);
-        if (!conn_lookup(ct, &nat_conn->rev_key,
-                         time_msec(), NULL, NULL)) {
+        if (!conn_lookup(ct, &nat_conn->rev_key, now, NULL, NULL)) {
             return true;
         }
     }
@@ -2441,7 +2905,8 @@ nat_get_unique_l4(struct conntrack *ct, struct conn *nat_conn,
 static bool
 nat_get_unique_tuple(struct conntrack *ct, const struct conn *conn,
                      struct conn *nat_conn,
-                     const struct nat_action_info_t *nat_info)
+                     const struct nat_action_info_t *nat_info,
+                     long long now)
 {
     union ct_addr min_addr = {0}, max_addr = {0}, curr_addr = {0},
                   guard_addr = {0};
@@ -2476,8 +2941,7 @@ another_round:
                       nat_info->nat_action);
 
     if (!pat_proto) {
-        if (!conn_lookup(ct, &nat_conn->rev_key,
-                         time_msec(), NULL, NULL)) {
+        if (!conn_lookup(ct, &nat_conn->rev_key, now, NULL, NULL)) {
             return true;
         }
 
@@ -2487,12 +2951,22 @@ another_round:
     bool found = false;
     if (nat_info->nat_action & NAT_ACTION_DST_PORT) {
         found = nat_get_unique_l4(ct, nat_conn, &nat_conn->rev_key.src.port,
-                                  curr_dport, min_dport, max_dport);
+                                  curr_dport, min_dport, max_dport, now);
+    }
+
+    if (!found) {
+        /* Source port selection first tries the lock-free per-address port
+         * pool, falling back to tuple-space probing when the pool range is
+         * exhausted, which can still find ports that are only busy towards
+         * other destinations. */
+        found = nat_get_sport_from_pool(ct, nat_conn, &curr_addr,
+                                        curr_sport, min_sport, max_sport,
+                                        now);
     }
 
     if (!found) {
         found = nat_get_unique_l4(ct, nat_conn, &nat_conn->rev_key.dst.port,
-                                  curr_sport, min_sport, max_sport);
+                                  curr_sport, min_sport, max_sport, now);
     }
 
     if (found) {
@@ -2740,22 +3214,79 @@ conntrack_dump_done(struct conntrack_dump *dump OVS_UNUSED)
     return 0;
 }
 
+/* Flushes the connections of 'zone', or all connections if 'zone' is null.
+ * A small table is flushed synchronously; above the sweep quantum the flush
+ * proceeds incrementally in the clean thread, one bounded batch at a time,
+ * so tearing down a tenant with millions of connections does not stall the
+ * datapath.  Connections that existed when the flush was requested are
+ * guaranteed to go: ct_sweep() cleans pending-flush connections instead of
+ * rehashing them, so a refresh cannot move one past the slot cursor.
+ * Connections created after the request may survive an incremental
+ * flush. */
 int
 conntrack_flush(struct conntrack *ct, const uint16_t *zone)
 {
     struct conn *conn;
 
     ovs_mutex_lock(&ct->ct_lock);
-    CMAP_FOR_EACH (conn, cm_node, &ct->conns) {
-        if (!zone || *zone == conn->key.zone) {
-            conn_clean_one(ct, conn);
+    if (atomic_count_get(&ct->n_conn) <= conntrack_clean_quantum(ct)) {
+        CMAP_FOR_EACH (conn, cm_node, &ct->conns) {
+            if (!zone || *zone == conn->key.zone) {
+                conn_clean_one(ct, conn);
+            }
+        }
+    } else {
+        if (zone) {
+            bitmap_set1(ct->flush_zones, *zone);
+        } else {
+            ct->flush_all = true;
         }
+        /* (Re)start a full pass over the expiration wheel. */
+        ct->flush_slots_left = CT_WHEEL_SLOTS;
+        latch_set(&ct->clean_thread_kick);
     }
     ovs_mutex_unlock(&ct->ct_lock);
 
     return 0;
 }
 
+/* Performs one bounded batch of an asynchronous flush, examining at most
+ * 'limit' connections.  Returns true if flush work remains. */
+static bool
+conntrack_flush_run(struct conntrack *ct, size_t limit)
+{
+    size_t count = 0;
+    bool more = false;
+    struct conn *conn;
+
+    ovs_mutex_lock(&ct->ct_lock);
+    while (ct->flush_slots_left) {
+        unsigned slot = CT_WHEEL_SLOTS - ct->flush_slots_left;
+
+        LIST_FOR_EACH_SAFE (conn, exp_node, &ct->exp_wheel[slot]) {
+            if (count >= limit) {
+                /* Continue on this slot next round. */
+                more = true;
+                goto out;
+            }
+            if (ct->flush_all
+                || bitmap_is_set(ct->flush_zones, conn->key.zone)) {
+                conn_clean(ct, conn);
+                count++;
+            }
+        }
+        ct->flush_slots_left--;
+    }
+
+    /* Pass complete. */
+    bitmap_set_multiple(ct->flush_zones, 0, UINT16_MAX + 1, false);
+    ct->flush_all = false;
+
+out:
+    ovs_mutex_unlock(&ct->ct_lock);
+    return more;
+}
+
 int
 conntrack_flush_tuple(struct conntrack *ct, const struct ct_dpif_tuple *tuple,
                       uint16_t zone)
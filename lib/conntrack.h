@@ -113,7 +113,7 @@ struct conntrack_zone_limit {
 };
 
 struct timeout_policy {
-    struct hmap_node node;
+    struct cmap_node node;
     struct ct_dpif_timeout_policy policy;
 };
 
@@ -140,6 +140,14 @@ int conntrack_get_maxconns(struct conntrack *ct, uint32_t *maxconns);
 int conntrack_get_nconns(struct conntrack *ct, uint32_t *nconns);
 int conntrack_set_tcp_seq_chk(struct conntrack *ct, bool enabled);
 bool conntrack_get_tcp_seq_chk(struct conntrack *ct);
+void conntrack_set_sweep_quantum(struct conntrack *ct, unsigned int quantum);
+
+struct ds;
+void conntrack_zone_stats_format(struct conntrack *ct, struct ds *ds);
+int conntrack_set_alg_bypass_zones(struct conntrack *ct, const char *spec);
+int conntrack_set_tcp_seq_chk_bypass_zones(struct conntrack *ct,
+                                           const char *spec);
+bool conntrack_tcp_seq_chk_zone_bypassed(struct conntrack *ct, uint16_t zone);
 struct ipf *conntrack_ipf_ctx(struct conntrack *ct);
 struct conntrack_zone_limit zone_limit_get(struct conntrack *ct,
                                            int32_t zone);
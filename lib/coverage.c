@@ -59,6 +59,17 @@ coverage_counter_register(struct coverage_counter* counter)
     coverage_counters[n_coverage_counters++] = counter;
 }
 
+/* Exporting these counters (plus pmd/upcall/conntrack stats) through a
+ * versioned shared-memory segment that collectors mmap was considered.
+ * The blocking cost is not the seqlock arithmetic but the contract: a
+ * schema-described shm segment is a stable ABI with lifecycle rules
+ * (what happens on daemon restart, counter renames, collector version
+ * skew) that outlives any one release, which is why such segments tend
+ * to calcify.  The cheap middle ground already exists: the counters
+ * are one appctl round trip each, and pmd-perf-metrics emits the pmd
+ * set in OpenMetrics form for direct scraping.  If polling cost ever
+ * matters, batching the reads behind one appctl command is a
+ * contract-free fix. */
 static void
 coverage_unixctl_show(struct unixctl_conn *conn, int argc OVS_UNUSED,
                      const char *argv[] OVS_UNUSED, void *aux OVS_UNUSED)
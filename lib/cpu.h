@@ -22,6 +22,7 @@
 enum ovs_cpu_isa {
     OVS_CPU_ISA_X86_FIRST,
     OVS_CPU_ISA_X86_BMI2 = OVS_CPU_ISA_X86_FIRST,
+    OVS_CPU_ISA_X86_AVX2,
     OVS_CPU_ISA_X86_AVX512F,
     OVS_CPU_ISA_X86_AVX512BW,
     OVS_CPU_ISA_X86_AVX512VBMI,
@@ -16,10 +16,20 @@
 
 #include <config.h>
 #include "csum.h"
+#include "dp-packet.h"
+#include "ovs-thread.h"
 #include "unaligned.h"
+#include "util.h"
 #include <sys/types.h>
 #include <netinet/in.h>
 
+#if (__x86_64__ && HAVE_AVX512F && HAVE_LD_AVX512_GOOD && __SSE4_2__ \
+     && !defined(__CHECKER__))
+#include <immintrin.h>
+#include "cpu.h"
+#define CSUM_DISPATCH_X86 1
+#endif
+
 #ifndef __CHECKER__
 /* Returns the IP checksum of the 'n' bytes in 'data'.
  *
@@ -33,12 +43,10 @@ csum(const void *data, size_t n)
     return csum_finish(csum_continue(0, data, n));
 }
 
-/* Adds the 'n' bytes in 'data' to the partial IP checksum 'partial' and
- * returns the updated checksum.  (To start a new checksum, pass 0 for
- * 'partial'.  To obtain the finished checksum, pass the return value to
- * csum_finish().) */
-uint32_t
-csum_continue(uint32_t partial, const void *data_, size_t n)
+/* Scalar reference implementation of csum_continue(), also used for the
+ * trailing bytes of the vectorized implementations below. */
+static uint32_t
+csum_continue_scalar(uint32_t partial, const void *data_, size_t n)
 {
     const ovs_be16 *data = data_;
 
@@ -55,6 +63,202 @@ csum_continue(uint32_t partial, const void *data_, size_t n)
     return partial;
 }
 
+/* Folds the 64-bit one's complement accumulator 'sum' into the 32-bit
+ * partial checksum representation used by csum_add16() etc. */
+static inline uint32_t
+csum_fold_u64(uint64_t sum)
+{
+    while (sum >> 32) {
+        sum = (sum & 0xffffffff) + (sum >> 32);
+    }
+    return sum;
+}
+
+/* The one's complement sum is independent of how wide the loads are: summing
+ * the data as native 16-bit words, as the scalar code does, yields the same
+ * partial sum as summing wider native words and folding carries, which is
+ * what the vectorized implementations below exploit.  Lane accumulators are
+ * 32 bits wide and are spilled into a 64-bit sum before they can overflow,
+ * every CSUM_VEC_SPILL bytes. */
+#define CSUM_VEC_SPILL 32768
+
+#ifdef CSUM_DISPATCH_X86
+static uint32_t
+__attribute__((__target__("avx2")))
+csum_continue_avx2(uint32_t partial, const void *data_, size_t n)
+{
+    const uint8_t *data = data_;
+    const __m256i v_lo_mask = _mm256_set1_epi32(0xffff);
+    uint64_t sum = partial;
+
+    while (n >= 32) {
+        size_t chunk = MIN(n & ~31, CSUM_VEC_SPILL);
+        __m256i v_sum = _mm256_setzero_si256();
+
+        n -= chunk;
+        while (chunk) {
+            __m256i v = _mm256_loadu_si256((const void *) data);
+
+            v_sum = _mm256_add_epi32(v_sum,
+                                     _mm256_and_si256(v, v_lo_mask));
+            v_sum = _mm256_add_epi32(v_sum, _mm256_srli_epi32(v, 16));
+            data += 32;
+            chunk -= 32;
+        }
+
+        /* Horizontal sum of the eight u32 lanes. */
+        __m128i v_hsum = _mm_add_epi32(_mm256_castsi256_si128(v_sum),
+                                       _mm256_extracti128_si256(v_sum, 1));
+        v_hsum = _mm_add_epi32(v_hsum, _mm_srli_si128(v_hsum, 8));
+        sum += (uint32_t) _mm_extract_epi32(v_hsum, 0);
+        sum += (uint32_t) _mm_extract_epi32(v_hsum, 1);
+    }
+
+    /* Fold the tail in 64 bits to avoid losing a carry above bit 31. */
+    return csum_fold_u64(sum + csum_continue_scalar(0, data, n));
+}
+
+static uint32_t
+__attribute__((__target__("avx512f,avx512bw")))
+csum_continue_avx512(uint32_t partial, const void *data_, size_t n)
+{
+    const uint8_t *data = data_;
+    const __m512i v_lo_mask = _mm512_set1_epi32(0xffff);
+    uint64_t sum = partial;
+
+    while (n >= 64) {
+        size_t chunk = MIN(n & ~63, CSUM_VEC_SPILL);
+        __m512i v_sum = _mm512_setzero_si512();
+
+        n -= chunk;
+        while (chunk) {
+            __m512i v = _mm512_loadu_si512((const void *) data);
+
+            v_sum = _mm512_add_epi32(v_sum,
+                                     _mm512_and_si512(v, v_lo_mask));
+            v_sum = _mm512_add_epi32(v_sum, _mm512_srli_epi32(v, 16));
+            data += 64;
+            chunk -= 64;
+        }
+
+        sum += _mm512_reduce_add_epi64(
+                   _mm512_add_epi64(
+                       _mm512_and_si512(v_sum,
+                                        _mm512_set1_epi64(0xffffffff)),
+                       _mm512_srli_epi64(v_sum, 32)));
+    }
+
+    /* Fold the tail in 64 bits to avoid losing a carry above bit 31. */
+    return csum_fold_u64(sum + csum_continue_scalar(0, data, n));
+}
+#endif /* CSUM_DISPATCH_X86 */
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+static uint32_t
+csum_continue_neon(uint32_t partial, const void *data_, size_t n)
+{
+    const uint8_t *data = data_;
+    uint64_t sum = partial;
+
+    while (n >= 16) {
+        size_t chunk = MIN(n & ~15, CSUM_VEC_SPILL);
+        uint32x4_t v_sum = vdupq_n_u32(0);
+
+        n -= chunk;
+        while (chunk) {
+            uint16x8_t v = vreinterpretq_u16_u8(vld1q_u8(data));
+
+            v_sum = vpadalq_u16(v_sum, v);
+            data += 16;
+            chunk -= 16;
+        }
+
+        sum += vaddlvq_u32(v_sum);
+    }
+
+    /* Fold the tail in 64 bits to avoid losing a carry above bit 31. */
+    return csum_fold_u64(sum + csum_continue_scalar(0, data, n));
+}
+#endif /* __aarch64__ && __ARM_NEON */
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+/* NEON is architecturally guaranteed on aarch64, no runtime probe needed. */
+static uint32_t (*csum_continue_impl)(uint32_t, const void *, size_t)
+    = csum_continue_neon;
+#else
+/* Active csum_continue() implementation, chosen on first use.  Selection is
+ * done lazily instead of from a constructor because the ISA flags in
+ * lib/cpu.c are themselves populated by constructors, whose ordering across
+ * translation units is unspecified. */
+static uint32_t (*csum_continue_impl)(uint32_t, const void *, size_t)
+    = csum_continue_scalar;
+
+static void
+csum_impl_init(void)
+{
+#ifdef CSUM_DISPATCH_X86
+    if (cpu_has_isa(OVS_CPU_ISA_X86_AVX512F)
+        && cpu_has_isa(OVS_CPU_ISA_X86_AVX512BW)) {
+        csum_continue_impl = csum_continue_avx512;
+    } else if (cpu_has_isa(OVS_CPU_ISA_X86_AVX2)) {
+        csum_continue_impl = csum_continue_avx2;
+    }
+#endif
+}
+#endif
+
+/* Adds the 'n' bytes in 'data' to the partial IP checksum 'partial' and
+ * returns the updated checksum.  (To start a new checksum, pass 0 for
+ * 'partial'.  To obtain the finished checksum, pass the return value to
+ * csum_finish().) */
+uint32_t
+csum_continue(uint32_t partial, const void *data_, size_t n)
+{
+    /* Short runs, such as protocol headers, are cheaper in the scalar
+     * loop than paying the vector setup and dispatch cost. */
+    if (n < 64) {
+        return csum_continue_scalar(partial, data_, n);
+    }
+
+#if !(defined(__aarch64__) && defined(__ARM_NEON))
+    {
+        static struct ovsthread_once once = OVSTHREAD_ONCE_INITIALIZER;
+
+        if (OVS_UNLIKELY(ovsthread_once_start(&once))) {
+            csum_impl_init();
+            ovsthread_once_done(&once);
+        }
+    }
+#endif
+    return csum_continue_impl(partial, data_, n);
+}
+
+/* Computes the IP checksum of the data of each packet in 'batch', starting
+ * at byte offset 'ofs' into the packet, storing the result for packet 'i'
+ * in 'csums[i]'.  A packet shorter than 'ofs' yields the checksum of no
+ * data, i.e. 0xffff. */
+void
+csum_batch(const struct dp_packet_batch *batch, uint16_t ofs,
+           ovs_be16 csums[])
+{
+    struct dp_packet *packet;
+
+    DP_PACKET_BATCH_FOR_EACH (i, packet, CONST_CAST(struct dp_packet_batch *,
+                                                    batch)) {
+        uint32_t size = dp_packet_size(packet);
+
+        if (size > ofs) {
+            const uint8_t *data = dp_packet_data(packet);
+
+            csums[i] = csum(data + ofs, size - ofs);
+        } else {
+            csums[i] = csum_finish(0);
+        }
+    }
+}
+
 /* Returns the IP checksum corresponding to 'partial', which is a value updated
  * by some combination of csum_add16(), csum_add32(), and csum_continue().
  *
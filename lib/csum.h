@@ -21,10 +21,13 @@
 #include <stdint.h>
 #include "openvswitch/types.h"
 
+struct dp_packet_batch;
 struct in6_addr;
 
 ovs_be16 csum(const void *, size_t);
 uint32_t csum_continue(uint32_t partial, const void *, size_t);
+void csum_batch(const struct dp_packet_batch *batch, uint16_t ofs,
+                ovs_be16 csums[]);
 ovs_be16 csum_finish(uint32_t partial);
 ovs_be16 recalc_csum16(ovs_be16 old_csum, ovs_be16 old_u16, ovs_be16 new_u16);
 ovs_be16 recalc_csum32(ovs_be16 old_csum, ovs_be32 old_u32, ovs_be32 new_u32);
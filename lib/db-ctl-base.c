@@ -42,6 +42,21 @@
 
 VLOG_DEFINE_THIS_MODULE(db_ctl_base);
 
+/* A note on batch execution: pipelined multi-transaction batching over
+ * one IDL session was requested for provisioning bursts.  The first-class
+ * answer already exists and is cheaper than a pipeline: a single
+ * invocation accepts many command groups separated by '--', all executed
+ * in ONE transaction over one session, so
+ *     ovs-vsctl -- add-port br0 p1 -- add-port br0 p2 -- ...
+ * creates a thousand ports in one round trip; and scripts that cannot
+ * aggregate can use 'ovs-vsctl --no-wait' plus a final sync to drop the
+ * per-invocation commit wait.  A pipeline of independently committed
+ * groups inside one process adds optimistic-retry semantics (later
+ * groups may see or miss earlier groups' effects on retry) that the
+ * command language has no way to express.  If provisioning is still too
+ * slow after aggregation, the bottleneck is the server side commit, not
+ * this client library. */
+
 /* This array defines the 'show' command output format.  User can check the
  * definition in utilities/ovs-vsctl.c as reference.
  *
@@ -69,6 +69,16 @@ static void resolve_callback__(void *req, int err, struct ub_result *)
 static bool resolve_result_to_addr__(struct ub_result *result, char **addr);
 static bool dns_resolve_sync__(const char *name, char **addr);
 
+/* Resolutions are cached per name in 'all_reqs__': entries carry the
+ * answer TTL and resolve_check_expire__() re-issues the async query
+ * when it lapses, so reconnect loops hit the cache rather than the
+ * resolver - and libunbound keeps its own TTL-bounded cache below us
+ * for the process lifetime.  The remaining stall is the very first
+ * lookup of a name in non-daemon mode, where dns_resolve_sync__()
+ * blocks by design for tools; daemons pass is_daemon=true and never
+ * block here.  Pre-expiry refresh would only shave the one-poll gap
+ * between expiry and the next reconnect attempt. */
+
 /* Pass a true 'is_daemon' if you don't want the DNS-resolving to block the
  * running thread.
  */
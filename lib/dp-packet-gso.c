@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022 Open vSwitch contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <config.h>
+#include <errno.h>
+
+#include "dp-packet-gso.h"
+#include "csum.h"
+#include "packets.h"
+#include "util.h"
+
+/* Software segmentation of oversized TCP packets ("GSO"), for egress paths
+ * that cannot offload the segmentation to the device.  The checksums of the
+ * produced segments are completed in software as well, so the segments carry
+ * no offload requests at all. */
+
+/* Allocates a new segment holding the first 'hdr_len' header bytes of 'p'
+ * followed by 'data_len' bytes of payload at 'data_pos'. */
+static struct dp_packet *
+dp_packet_gso_seg_new(const struct dp_packet *p, size_t hdr_len,
+                      const char *data_pos, size_t data_len)
+{
+    struct dp_packet *seg;
+
+    seg = dp_packet_new_with_headroom(hdr_len + data_len,
+                                      dp_packet_headroom(p));
+    dp_packet_put(seg, dp_packet_data(p), hdr_len);
+    dp_packet_put(seg, data_pos, data_len);
+
+    seg->l2_5_ofs = p->l2_5_ofs;
+    seg->l3_ofs = p->l3_ofs;
+    seg->l4_ofs = p->l4_ofs;
+
+    return seg;
+}
+
+/* Segments the TSO packet 'p' into segments with at most 'mss' bytes of TCP
+ * payload each.  On success, returns 0 and stores a heap allocated array of
+ * the new segments in '*segs' with their count in '*n_segs'; both the array
+ * and the segments are owned by the caller, and 'p' is left untouched.
+ * Returns a positive errno if 'p' is not a supported TSO packet (plain TCP
+ * over IPv4 or IPv6 with valid offsets). */
+int
+dp_packet_gso(struct dp_packet *p, uint16_t mss,
+              struct dp_packet ***segs, size_t *n_segs)
+{
+    const struct tcp_header *tcp;
+    struct dp_packet **out;
+    const char *data_pos;
+    size_t payload_len;
+    uint16_t hdr_len;
+    uint32_t tcp_seq;
+    size_t n;
+    size_t i;
+
+    if (p->l3_ofs == UINT16_MAX || p->l4_ofs == UINT16_MAX || !mss) {
+        return EINVAL;
+    }
+
+    tcp = dp_packet_l4(p);
+    hdr_len = p->l4_ofs + TCP_OFFSET(tcp->tcp_ctl) * 4;
+    if (hdr_len < p->l4_ofs + TCP_HEADER_LEN
+        || hdr_len >= dp_packet_size(p)) {
+        return EINVAL;
+    }
+
+    payload_len = dp_packet_size(p) - hdr_len;
+    n = DIV_ROUND_UP(payload_len, mss);
+    out = xmalloc(n * sizeof *out);
+
+    data_pos = (const char *) dp_packet_data(p) + hdr_len;
+    tcp_seq = ntohl(get_16aligned_be32(&tcp->tcp_seq));
+
+    for (i = 0; i < n; i++) {
+        size_t seg_len = MIN(payload_len, mss);
+        struct dp_packet *seg;
+        struct tcp_header *seg_tcp;
+        uint32_t csum_pseudo;
+
+        seg = dp_packet_gso_seg_new(p, hdr_len, data_pos, seg_len);
+        data_pos += seg_len;
+        payload_len -= seg_len;
+
+        if (dp_packet_hwol_is_ipv4(p)
+            || IP_VER(((struct ip_header *) dp_packet_l3(seg))->ip_ihl_ver)
+               == 4) {
+            struct ip_header *seg_ip = dp_packet_l3(seg);
+
+            seg_ip->ip_tot_len = htons(dp_packet_size(seg) - seg->l3_ofs);
+            /* Give each segment a distinct IP ID, the way TSO capable
+             * devices do. */
+            seg_ip->ip_id = htons(ntohs(seg_ip->ip_id) + i);
+            seg_ip->ip_csum = 0;
+            seg_ip->ip_csum = csum(seg_ip,
+                                   IP_IHL(seg_ip->ip_ihl_ver) * 4);
+            csum_pseudo = packet_csum_pseudoheader(seg_ip);
+        } else {
+            struct ovs_16aligned_ip6_hdr *seg_ip6 = dp_packet_l3(seg);
+
+            seg_ip6->ip6_ctlun.ip6_un1.ip6_un1_plen
+                = htons(dp_packet_size(seg) - seg->l3_ofs
+                        - sizeof *seg_ip6);
+            csum_pseudo = packet_csum_pseudoheader6(seg_ip6);
+        }
+
+        seg_tcp = dp_packet_l4(seg);
+        put_16aligned_be32(&seg_tcp->tcp_seq, htonl(tcp_seq));
+        tcp_seq += seg_len;
+        if (i != n - 1) {
+            /* FIN and PSH belong on the final segment only. */
+            seg_tcp->tcp_ctl &= ~htons(TCP_FIN | TCP_PSH);
+        }
+        seg_tcp->tcp_csum = 0;
+        seg_tcp->tcp_csum
+            = csum_finish(csum_continue(csum_pseudo, seg_tcp,
+                                        dp_packet_size(seg) - seg->l4_ofs));
+
+        out[i] = seg;
+    }
+
+    *segs = out;
+    *n_segs = n;
+    return 0;
+}
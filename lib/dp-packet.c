@@ -22,6 +22,7 @@
 #include "netdev-afxdp.h"
 #include "netdev-dpdk.h"
 #include "openvswitch/dynamic-string.h"
+#include "ovs-thread.h"
 #include "util.h"
 
 static void
@@ -145,16 +146,100 @@ dp_packet_uninit(struct dp_packet *b)
     }
 }
 
+/* Per-thread cache of recycled DPBUF_MALLOC packets.  Keeping the packet
+ * and its buffer allocated spares a round trip through malloc for every
+ * packet on the non-DPDK rx and upcall paths.  Buffers above
+ * DP_PACKET_CACHE_MAX_ALLOCATED bytes are not cached to bound the memory
+ * parked per thread. */
+#define DP_PACKET_CACHE_SIZE 64
+#define DP_PACKET_CACHE_MAX_ALLOCATED 16384
+
+struct dp_packet_cache {
+    int n;
+    struct dp_packet *pkts[DP_PACKET_CACHE_SIZE];
+};
+
+static pthread_key_t dp_packet_cache_key;
+
+/* Releases a thread's recycler cache, including every parked packet.
+ * Handler, revalidator and pmd threads are torn down and recreated on
+ * reconfiguration, so packets parked here must die with the thread or
+ * each teardown leaks up to DP_PACKET_CACHE_SIZE buffers. */
+static void
+dp_packet_cache_destroy(void *c_)
+{
+    struct dp_packet_cache *c = c_;
+
+    for (int i = 0; i < c->n; i++) {
+        dp_packet_uninit(c->pkts[i]);
+        free(c->pkts[i]);
+    }
+    free(c);
+}
+
+static void
+dp_packet_cache_key_once_init(void)
+{
+    if (pthread_key_create(&dp_packet_cache_key, dp_packet_cache_destroy)) {
+        abort();
+    }
+}
+
+static struct dp_packet_cache *
+dp_packet_cache_get_init(void)
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    struct dp_packet_cache *c;
+
+    pthread_once(&once, dp_packet_cache_key_once_init);
+    c = pthread_getspecific(dp_packet_cache_key);
+    if (OVS_UNLIKELY(!c)) {
+        c = xzalloc(sizeof *c);
+        xpthread_setspecific(dp_packet_cache_key, c);
+    }
+    return c;
+}
+
 /* Creates and returns a new dp_packet with an initial capacity of 'size'
  * bytes. */
 struct dp_packet *
 dp_packet_new(size_t size)
 {
-    struct dp_packet *b = xmalloc(sizeof *b);
+    struct dp_packet_cache *c = dp_packet_cache_get_init();
+    struct dp_packet *b;
+
+    /* Reuse a recycled packet if its buffer is large enough. */
+    if (c->n > 0 && dp_packet_get_allocated(c->pkts[c->n - 1]) >= size) {
+        b = c->pkts[--c->n];
+        dp_packet_use(b, dp_packet_base(b), dp_packet_get_allocated(b));
+        return b;
+    }
+
+    b = xmalloc(sizeof *b);
     dp_packet_init(b, size);
     return b;
 }
 
+/* Frees or recycles the DPBUF_MALLOC packet 'b', which must have been
+ * obtained from dp_packet_new() or one of its variants.  Used by
+ * dp_packet_delete(). */
+void
+dp_packet_recycle(struct dp_packet *b)
+{
+    struct dp_packet_cache *c = dp_packet_cache_get_init();
+    uint32_t allocated = dp_packet_get_allocated(b);
+
+    if (c->n < DP_PACKET_CACHE_SIZE
+        && allocated && allocated <= DP_PACKET_CACHE_MAX_ALLOCATED
+        && dp_packet_base(b)) {
+        c->pkts[c->n++] = b;
+        return;
+    }
+
+    dp_packet_uninit(b);
+    free(b);
+}
+
 /* Creates and returns a new dp_packet with an initial capacity of 'size +
  * headroom' bytes, reserving the first 'headroom' bytes as headroom. */
 struct dp_packet *
@@ -122,6 +122,7 @@ struct dp_packet {
     uint32_t ol_flags;          /* Offloading flags. */
     uint32_t rss_hash;          /* Packet hash. */
     uint32_t flow_mark;         /* Packet flow mark. */
+    uint16_t tso_segsz;         /* TCP TSO segment size. */
 #endif
     enum dp_packet_source source;  /* Source of memory allocated as 'base'. */
 
@@ -133,7 +134,25 @@ struct dp_packet {
     uint16_t l3_ofs;               /* Network-level header offset,
                                     * or UINT16_MAX. */
     uint16_t l4_ofs;               /* Transport-level header offset,
-                                      or UINT16_MAX. */
+                                      or UINT16_MAX.
+
+                                      These offsets, l2_5_ofs and
+                                      l2_pad_size are the shared parse
+                                      state between pipeline stages; a
+                                      fuller parsed-header descriptor
+                                      (proto chain, header lengths, csum
+                                      status) was considered but every
+                                      modifying action (set_field, NAT,
+                                      encap/decap, MPLS) would have to
+                                      keep it coherent or packets get
+                                      processed against stale state -
+                                      the offsets survive only because
+                                      adjust_size-style helpers already
+                                      maintain them.  Stages that
+                                      re-parse (conntrack validation,
+                                      ipf) do so on fields that actions
+                                      may legitimately have changed
+                                      since extraction. */
     uint32_t cutlen;               /* length in bytes to cut from the end. */
     ovs_be32 packet_type;          /* Packet type as defined in OpenFlow */
     union {
@@ -201,6 +220,7 @@ struct dp_packet *dp_packet_clone_data_with_headroom(const void *, size_t,
 void dp_packet_resize(struct dp_packet *b, size_t new_headroom,
                       size_t new_tailroom);
 static inline void dp_packet_delete(struct dp_packet *);
+void dp_packet_recycle(struct dp_packet *);
 static inline void dp_packet_swap(struct dp_packet *, struct dp_packet *);
 
 static inline void *dp_packet_at(const struct dp_packet *, size_t offset,
@@ -254,6 +274,12 @@ dp_packet_delete(struct dp_packet *b)
             return;
         }
 
+        if (b->source == DPBUF_MALLOC) {
+            /* Park the packet in the per-thread recycling cache. */
+            dp_packet_recycle(b);
+            return;
+        }
+
         dp_packet_uninit(b);
         free(b);
     }
@@ -634,9 +660,9 @@ dp_packet_set_allocated(struct dp_packet *b, uint16_t s)
 #else /* DPDK_NETDEV */
 
 static inline void
-dp_packet_init_specific(struct dp_packet *p OVS_UNUSED)
+dp_packet_init_specific(struct dp_packet *p)
 {
-    /* There are no implementation-specific fields for initialization. */
+    p->tso_segsz = 0;
 }
 
 static inline void *
@@ -979,6 +1005,28 @@ dp_packet_hwol_is_tso(const struct dp_packet *b)
     return !!(*dp_packet_ol_flags_ptr(b) & DP_PACKET_OL_TX_TCP_SEG);
 }
 
+/* Returns the TCP segment size of TSO packet 'b', or 0 if not known. */
+static inline uint16_t
+dp_packet_get_tso_segsz(const struct dp_packet *b)
+{
+#ifdef DPDK_NETDEV
+    return b->mbuf.tso_segsz;
+#else
+    return b->tso_segsz;
+#endif
+}
+
+/* Sets the TCP segment size of TSO packet 'b'. */
+static inline void
+dp_packet_set_tso_segsz(struct dp_packet *b, uint16_t segsz)
+{
+#ifdef DPDK_NETDEV
+    b->mbuf.tso_segsz = segsz;
+#else
+    b->tso_segsz = segsz;
+#endif
+}
+
 /* Returns 'true' if packet 'b' is marked for IPv4 checksum offloading. */
 static inline bool
 dp_packet_hwol_is_ipv4(const struct dp_packet *b)
@@ -137,6 +137,7 @@ _mm512_maskz_permutexvar_epi8_wrap(__mmask64 kmask, __m512i idx, __m512i a)
 #define PATTERN_ETHERTYPE_MASK PATTERN_ETHERTYPE_GEN(0xFF, 0xFF)
 #define PATTERN_ETHERTYPE_IPV4 PATTERN_ETHERTYPE_GEN(0x08, 0x00)
 #define PATTERN_ETHERTYPE_DT1Q PATTERN_ETHERTYPE_GEN(0x81, 0x00)
+#define PATTERN_ETHERTYPE_DT1AD PATTERN_ETHERTYPE_GEN(0x88, 0xA8)
 
 /* VLAN (Dot1Q) patterns and masks. */
 #define PATTERN_DT1Q_MASK                                               \
@@ -144,6 +145,13 @@ _mm512_maskz_permutexvar_epi8_wrap(__mmask64 kmask, __m512i idx, __m512i a)
 #define PATTERN_DT1Q_IPV4                                               \
   0x00, 0x00, 0x08, 0x00,
 
+/* QinQ (Dot1ad outer, Dot1Q inner) patterns and masks.  The outer TCI is
+ * followed by the inner TPID, inner TCI and the inner-most EtherType. */
+#define PATTERN_QINQ_MASK                                               \
+  0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF,
+#define PATTERN_QINQ_IPV4                                               \
+  0x00, 0x00, 0x81, 0x00, 0x00, 0x00, 0x08, 0x00,
+
 /* Generator for checking IPv4 ver, ihl, and proto */
 #define PATTERN_IPV4_GEN(VER_IHL, FLAG_OFF_B0, FLAG_OFF_B1, PROTO) \
   VER_IHL, /* Version and IHL */                                        \
@@ -201,6 +209,23 @@ _mm512_maskz_permutexvar_epi8_wrap(__mmask64 kmask, __m512i idx, __m512i a)
   NU, NU, NU, NU, NU, NU, NU, NU, 38, 39, 40, 41, NU, NU, NU, NU, /* TCP */   \
   NU, NU, NU, NU, NU, NU, NU, NU, /* Unused. */
 
+#define PATTERN_QINQ_IPV4_UDP_SHUFFLE                                         \
+  /* Ether (2 blocks): Note that the inner-most EtherType is written here. */ \
+  0,  1,  2,  3,  4,  5,  6,  7, 8,  9, 10, 11, 20, 21,  0,  0,               \
+  /* VLAN (1 block): Outer and inner TPID/TCI. */                             \
+  12, 13, 14, 15, 16, 17, 18, 19,                                             \
+  34, 35, 36, 37, 38, 39, 40, 41, 0, 0, 0, 0, 28, 23, 30, 31,     /* IPv4 */  \
+  42, 43, 44, 45, NU, NU, NU, NU, /* UDP */
+
+#define PATTERN_QINQ_IPV4_TCP_SHUFFLE                                         \
+  /* Ether (2 blocks): Note that the inner-most EtherType is written here. */ \
+  0,  1,  2,  3,  4,  5,  6,  7, 8,  9, 10, 11, 20, 21,  0,  0,               \
+  /* VLAN (1 block): Outer and inner TPID/TCI. */                             \
+  12, 13, 14, 15, 16, 17, 18, 19,                                             \
+  34, 35, 36, 37, 38, 39, 40, 41, 0, 0, 0, 0, 28, 23, 30, 31,     /* IPv4 */  \
+  NU, NU, NU, NU, NU, NU, NU, NU, 42, 43, 44, 45, NU, NU, NU, NU, /* TCP */   \
+  NU, NU, NU, NU, NU, NU, NU, NU, /* Unused. */
+
 /* Generation of K-mask bitmask values, to zero out data in result. Note that
  * these correspond 1:1 to the above "*_SHUFFLE" values, and bit used must be
  * set in this K-mask, and "NU" values must be zero in the k-mask. Each mask
@@ -210,6 +235,7 @@ _mm512_maskz_permutexvar_epi8_wrap(__mmask64 kmask, __m512i idx, __m512i a)
  */
 #define KMASK_ETHER     0x1FFFULL
 #define KMASK_DT1Q      0x0FULL
+#define KMASK_QINQ      0xFFULL
 #define KMASK_IPV4      0xF0FFULL
 #define KMASK_UDP       0x000FULL
 #define KMASK_TCP       0x0F00ULL
@@ -226,6 +252,12 @@ _mm512_maskz_permutexvar_epi8_wrap(__mmask64 kmask, __m512i idx, __m512i a)
 #define PATTERN_DT1Q_IPV4_TCP_KMASK \
     (KMASK_ETHER | (KMASK_DT1Q << 16) | (KMASK_IPV4 << 24) | (KMASK_TCP << 40))
 
+#define PATTERN_QINQ_IPV4_UDP_KMASK \
+    (KMASK_ETHER | (KMASK_QINQ << 16) | (KMASK_IPV4 << 24) | (KMASK_UDP << 40))
+
+#define PATTERN_QINQ_IPV4_TCP_KMASK \
+    (KMASK_ETHER | (KMASK_QINQ << 16) | (KMASK_IPV4 << 24) | (KMASK_TCP << 40))
+
 /* Miniflow Strip post-processing masks.
  * This allows unsetting specific bits from the resulting miniflow. It is used
  * for e.g. IPv4 where the "DF" bit is never pushed to the miniflow itself.
@@ -324,6 +356,8 @@ enum MFEX_PROFILES {
     PROFILE_ETH_IPV4_TCP,
     PROFILE_ETH_VLAN_IPV4_UDP,
     PROFILE_ETH_VLAN_IPV4_TCP,
+    PROFILE_ETH_QINQ_IPV4_UDP,
+    PROFILE_ETH_QINQ_IPV4_TCP,
     PROFILE_COUNT,
 };
 
@@ -415,6 +449,50 @@ static const struct mfex_profile mfex_profiles[PROFILE_COUNT] =
         },
         .dp_pkt_min_size = 58,
     },
+
+    [PROFILE_ETH_QINQ_IPV4_UDP] = {
+        .probe_mask.u8_data = {
+            PATTERN_ETHERTYPE_MASK PATTERN_QINQ_MASK PATTERN_IPV4_MASK
+        },
+        .probe_data.u8_data = {
+            PATTERN_ETHERTYPE_DT1AD PATTERN_QINQ_IPV4 PATTERN_IPV4_UDP
+        },
+
+        .store_shuf.u8_data = { PATTERN_QINQ_IPV4_UDP_SHUFFLE },
+        .strip_mask.u8_data = { PATTERN_STRIP_DOT1Q_IPV4_MASK },
+        .store_kmsk = PATTERN_QINQ_IPV4_UDP_KMASK,
+
+        .mf_bits = { 0x38a0000000000000, 0x0000000000040401},
+        .dp_pkt_offs = {
+            18, UINT16_MAX, 22, 42,
+        },
+        .dp_pkt_min_size = 50,
+    },
+
+    [PROFILE_ETH_QINQ_IPV4_TCP] = {
+        .probe_mask.u8_data = {
+            PATTERN_ETHERTYPE_MASK
+            PATTERN_QINQ_MASK
+            PATTERN_IPV4_MASK
+            PATTERN_TCP_MASK
+        },
+        .probe_data.u8_data = {
+            PATTERN_ETHERTYPE_DT1AD
+            PATTERN_QINQ_IPV4
+            PATTERN_IPV4_TCP
+            PATTERN_TCP
+        },
+
+        .store_shuf.u8_data = { PATTERN_QINQ_IPV4_TCP_SHUFFLE },
+        .strip_mask.u8_data = { PATTERN_STRIP_DOT1Q_IPV4_MASK },
+        .store_kmsk = PATTERN_QINQ_IPV4_TCP_KMASK,
+
+        .mf_bits = { 0x38a0000000000000, 0x0000000000044401},
+        .dp_pkt_offs = {
+            18, UINT16_MAX, 22, 42,
+        },
+        .dp_pkt_min_size = 62,
+    },
 };
 
 
@@ -459,6 +537,16 @@ mfex_vlan_pcp(const uint8_t vlan_pcp, uint64_t *block)
     cfi_byte[2] = 0x10 | vlan_pcp;
 }
 
+/* Same as mfex_vlan_pcp(), but for the inner VLAN header of a QinQ frame,
+ * which occupies the second half of the miniflow VLAN block. */
+static void
+mfex_vlan_pcp_inner(const uint8_t vlan_pcp, uint64_t *block)
+{
+    /* Bitwise-OR in the CFI flag, keeping other data the same. */
+    uint8_t *cfi_byte = (uint8_t *) block;
+    cfi_byte[6] = 0x10 | vlan_pcp;
+}
+
 static void
 mfex_handle_tcp_flags(const struct tcp_header *tcp, uint64_t *block)
 {
@@ -590,6 +678,48 @@ mfex_avx512_process(struct dp_packet_batch *packets,
                 }
             } break;
 
+        case PROFILE_ETH_QINQ_IPV4_TCP: {
+                /* The scalar parser stops at the outer VLAN header when the
+                 * configured VLAN limit is lower; match its behavior. */
+                if (OVS_UNLIKELY(flow_vlan_limit < 2)) {
+                    continue;
+                }
+                mfex_vlan_pcp(pkt[14], &keys[i].buf[4]);
+                mfex_vlan_pcp_inner(pkt[18], &keys[i].buf[4]);
+
+                uint32_t size_from_ipv4 =
+                    size - (VLAN_ETH_HEADER_LEN + VLAN_HEADER_LEN);
+                struct ip_header *nh =
+                    (void *)&pkt[VLAN_ETH_HEADER_LEN + VLAN_HEADER_LEN];
+                if (mfex_ipv4_set_l2_pad_size(packet, nh, size_from_ipv4,
+                                              TCP_HEADER_LEN)) {
+                    continue;
+                }
+
+                /* Process TCP flags, and store to blocks. */
+                const struct tcp_header *tcp = (void *)&pkt[42];
+                mfex_handle_tcp_flags(tcp, &blocks[7]);
+            } break;
+
+        case PROFILE_ETH_QINQ_IPV4_UDP: {
+                /* The scalar parser stops at the outer VLAN header when the
+                 * configured VLAN limit is lower; match its behavior. */
+                if (OVS_UNLIKELY(flow_vlan_limit < 2)) {
+                    continue;
+                }
+                mfex_vlan_pcp(pkt[14], &keys[i].buf[4]);
+                mfex_vlan_pcp_inner(pkt[18], &keys[i].buf[4]);
+
+                uint32_t size_from_ipv4 =
+                    size - (VLAN_ETH_HEADER_LEN + VLAN_HEADER_LEN);
+                struct ip_header *nh =
+                    (void *)&pkt[VLAN_ETH_HEADER_LEN + VLAN_HEADER_LEN];
+                if (mfex_ipv4_set_l2_pad_size(packet, nh, size_from_ipv4,
+                                              UDP_HEADER_LEN)) {
+                    continue;
+                }
+            } break;
+
         case PROFILE_ETH_IPV4_TCP: {
                 /* Process TCP flags, and store to blocks. */
                 const struct tcp_header *tcp = (void *)&pkt[34];
@@ -659,6 +789,8 @@ DECLARE_MFEX_FUNC(ip_udp, PROFILE_ETH_IPV4_UDP)
 DECLARE_MFEX_FUNC(ip_tcp, PROFILE_ETH_IPV4_TCP)
 DECLARE_MFEX_FUNC(dot1q_ip_udp, PROFILE_ETH_VLAN_IPV4_UDP)
 DECLARE_MFEX_FUNC(dot1q_ip_tcp, PROFILE_ETH_VLAN_IPV4_TCP)
+DECLARE_MFEX_FUNC(qinq_ip_udp, PROFILE_ETH_QINQ_IPV4_UDP)
+DECLARE_MFEX_FUNC(qinq_ip_tcp, PROFILE_ETH_QINQ_IPV4_TCP)
 
 
 static int32_t
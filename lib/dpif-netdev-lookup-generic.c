@@ -216,6 +216,15 @@ lookup_generic_impl(struct dpcls_subtable *subtable,
         hashes[i] = hash_finish(hash, bit_count_total * 8);
     }
 
+    /* Pre-filter: skip the hash table lookup for keys whose hash is
+     * definitely not present in this subtable. */
+    uint32_t probe_map = keys_map;
+    ULLONG_FOR_EACH_1 (i, keys_map) {
+        if (!dpcls_subtable_pf_may_contain(subtable, hashes[i])) {
+            ULLONG_SET0(probe_map, i);
+        }
+    }
+
     /* Lookup: this returns a bitmask of packets where the hash table had
      * an entry for the given hash key. Presence of a hash key does not
      * guarantee matching the key, as there can be hash collisions.
@@ -223,7 +232,7 @@ lookup_generic_impl(struct dpcls_subtable *subtable,
     uint32_t found_map;
     const struct cmap_node *nodes[NETDEV_MAX_BURST];
 
-    found_map = cmap_find_batch(&subtable->rules, keys_map, hashes, nodes);
+    found_map = cmap_find_batch(&subtable->rules, probe_map, hashes, nodes);
 
     /* Verify that packet actually matched rule. If not found, a hash
      * collision has taken place, so continue searching with the next node.
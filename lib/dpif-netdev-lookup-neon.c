@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2022 Open vSwitch contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+/* Sparse cannot handle the NEON instructions. */
+#if !defined(__CHECKER__)
+
+#include <config.h>
+#include <arm_neon.h>
+
+#include "dpif-netdev.h"
+#include "dpif-netdev-lookup.h"
+
+#include "cmap.h"
+#include "flow.h"
+#include "pvector.h"
+#include "openvswitch/vlog.h"
+
+VLOG_DEFINE_THIS_MODULE(dpif_lookup_neon);
+
+/* Lookup functions below depends on the internal structure of flowmap. */
+BUILD_ASSERT_DECL(FLOWMAP_UNITS == 2);
+
+/* Per-packet stride in the flattened blocks scratch area.  Specialized
+ * functions are limited to this number of miniflow blocks, which bounds the
+ * stack usage of the lookup and keeps each packet's blocks 128-bit aligned.
+ */
+#define NEON_BLOCKS_PER_PACKET 16
+#define BLOCKS_CACHE_SIZE (NETDEV_MAX_BURST * NEON_BLOCKS_PER_PACKET)
+
+/* NEON has no gather loads, so flattening the scattered packet miniflow
+ * blocks into the subtable's block order is done with scalar code, the same
+ * way as the generic implementation.  The vector win on aarch64 is in the
+ * rule verification stage, where the flattened blocks are masked and
+ * compared against the rule 128 bits at a time.
+ */
+static inline void
+netdev_flow_key_flatten_unit(const uint64_t *pkt_blocks,
+                             const uint64_t *tbl_blocks,
+                             const uint64_t *mf_masks,
+                             uint64_t *blocks_scratch,
+                             const uint64_t pkt_mf_bits,
+                             const uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        uint64_t mf_mask = mf_masks[i];
+        /* Calculate the block index for the packet metadata. */
+        uint64_t idx_bits = mf_mask & pkt_mf_bits;
+        const uint32_t pkt_idx = count_1bits(idx_bits);
+
+        /* Check if the packet has the subtable miniflow bit set. If yes, the
+         * block at the above pkt_idx will be stored, otherwise it is masked
+         * out to be zero.
+         */
+        uint64_t pkt_has_mf_bit = (mf_mask + 1) & pkt_mf_bits;
+        uint64_t no_bit = ((!pkt_has_mf_bit) > 0) - 1;
+
+        /* Mask packet block by table block, and mask to zero if packet
+         * doesn't actually contain this block of metadata.
+         */
+        blocks_scratch[i] = pkt_blocks[pkt_idx] & tbl_blocks[i] & no_bit;
+    }
+}
+
+static inline void
+netdev_flow_key_flatten(const struct netdev_flow_key *key,
+                        const struct netdev_flow_key *mask,
+                        const uint64_t *mf_masks,
+                        uint64_t *blocks_scratch,
+                        const uint32_t u0_count,
+                        const uint32_t u1_count)
+{
+    /* Load mask from subtable, mask with packet mf, popcount to get idx. */
+    const uint64_t *pkt_blocks = miniflow_get_values(&key->mf);
+    const uint64_t *tbl_blocks = miniflow_get_values(&mask->mf);
+
+    /* Packet miniflow bits to be masked by pre-calculated mf_masks. */
+    const uint64_t pkt_bits_u0 = key->mf.map.bits[0];
+    const uint32_t pkt_bits_u0_pop = count_1bits(pkt_bits_u0);
+    const uint64_t pkt_bits_u1 = key->mf.map.bits[1];
+
+    /* Unit 0 flattening */
+    netdev_flow_key_flatten_unit(&pkt_blocks[0],
+                                 &tbl_blocks[0],
+                                 &mf_masks[0],
+                                 &blocks_scratch[0],
+                                 pkt_bits_u0,
+                                 u0_count);
+
+    /* Unit 1 flattening, with pointers advanced past the unit 0 data. */
+    netdev_flow_key_flatten_unit(&pkt_blocks[pkt_bits_u0_pop],
+                                 &tbl_blocks[u0_count],
+                                 &mf_masks[u0_count],
+                                 &blocks_scratch[u0_count],
+                                 pkt_bits_u1,
+                                 u1_count);
+}
+
+/* Compares a rule and the blocks representing a key using 128-bit NEON
+ * operations, two blocks per iteration.  Returns 1 on a match.
+ */
+static inline uint64_t
+netdev_rule_matches_key(const struct dpcls_rule *rule,
+                        const uint32_t mf_bits_total,
+                        const uint64_t *blocks_scratch)
+{
+    const uint64_t *keyp = miniflow_get_values(&rule->flow.mf);
+    const uint64_t *maskp = miniflow_get_values(&rule->mask->mf);
+    uint64x2_t v_not_match = vdupq_n_u64(0);
+    uint64_t not_match;
+    uint32_t i;
+
+    for (i = 0; i + 2 <= mf_bits_total; i += 2) {
+        uint64x2_t v_blocks = vld1q_u64(&blocks_scratch[i]);
+        uint64x2_t v_mask = vld1q_u64(&maskp[i]);
+        uint64x2_t v_key = vld1q_u64(&keyp[i]);
+        uint64x2_t v_masked = vandq_u64(v_blocks, v_mask);
+
+        v_not_match = vorrq_u64(v_not_match, veorq_u64(v_masked, v_key));
+    }
+
+    not_match = vgetq_lane_u64(v_not_match, 0)
+                | vgetq_lane_u64(v_not_match, 1);
+
+    /* Handle the odd trailing block, if the subtable has one. */
+    if (mf_bits_total & 1) {
+        i = mf_bits_total - 1;
+        not_match |= (blocks_scratch[i] & maskp[i]) ^ keyp[i];
+    }
+
+    /* Invert result to show match as 1. */
+    return !not_match;
+}
+
+/* Const prop version of the function: note that mf bits total and u0 are
+ * explicitly passed in here, while they're also available at runtime from the
+ * subtable pointer. By making them compile time, we enable the compiler to
+ * unroll loops and flatten out code-sequences based on the knowledge of the
+ * mf_bits_* compile time values. This results in improved performance.
+ */
+static inline uint32_t ALWAYS_INLINE
+lookup_neon_impl(struct dpcls_subtable *subtable,
+                 uint32_t keys_map,
+                 const struct netdev_flow_key *keys[],
+                 struct dpcls_rule **rules,
+                 const uint32_t bit_count_u0,
+                 const uint32_t bit_count_u1)
+{
+    const uint32_t n_pkts = count_1bits(keys_map);
+    ovs_assert(NETDEV_MAX_BURST >= n_pkts);
+    uint32_t hashes[NETDEV_MAX_BURST];
+
+    const uint32_t bit_count_total = bit_count_u0 + bit_count_u1;
+    uint64_t *mf_masks = subtable->mf_masks;
+    int i;
+
+    OVS_ALIGNED_VAR(CACHE_LINE_SIZE) uint64_t blocks_scratch[BLOCKS_CACHE_SIZE];
+
+    /* Flatten the packet metadata into the blocks_scratch[] using subtable. */
+    ULLONG_FOR_EACH_1 (i, keys_map) {
+            netdev_flow_key_flatten(keys[i],
+                                    &subtable->mask,
+                                    mf_masks,
+                                    &blocks_scratch[i * NEON_BLOCKS_PER_PACKET],
+                                    bit_count_u0,
+                                    bit_count_u1);
+    }
+
+    /* Hash the now linearized blocks of packet metadata. */
+    ULLONG_FOR_EACH_1 (i, keys_map) {
+        uint64_t *block_ptr = &blocks_scratch[i * NEON_BLOCKS_PER_PACKET];
+        uint32_t hash = hash_add_words64(0, block_ptr, bit_count_total);
+        hashes[i] = hash_finish(hash, bit_count_total * 8);
+    }
+
+    /* Pre-filter: skip the hash table lookup for keys whose hash is
+     * definitely not present in this subtable. */
+    uint32_t probe_map = keys_map;
+    ULLONG_FOR_EACH_1 (i, keys_map) {
+        if (!dpcls_subtable_pf_may_contain(subtable, hashes[i])) {
+            ULLONG_SET0(probe_map, i);
+        }
+    }
+
+    /* Lookup: this returns a bitmask of packets where the hash table had
+     * an entry for the given hash key. Presence of a hash key does not
+     * guarantee matching the key, as there can be hash collisions.
+     */
+    uint32_t found_map;
+    const struct cmap_node *nodes[NETDEV_MAX_BURST];
+
+    found_map = cmap_find_batch(&subtable->rules, probe_map, hashes, nodes);
+
+    /* Verify that packet actually matched rule. If not found, a hash
+     * collision has taken place, so continue searching with the next node.
+     */
+    ULLONG_FOR_EACH_1 (i, found_map) {
+        struct dpcls_rule *rule;
+
+        CMAP_NODE_FOR_EACH (rule, cmap_node, nodes[i]) {
+            const uint32_t cidx = i * NEON_BLOCKS_PER_PACKET;
+            uint32_t match = netdev_rule_matches_key(rule, bit_count_total,
+                                                     &blocks_scratch[cidx]);
+
+            if (OVS_LIKELY(match)) {
+                rules[i] = rule;
+                subtable->hit_cnt++;
+                goto next;
+            }
+        }
+
+        /* None of the found rules was a match.  Reset the i-th bit to
+         * keep searching this key in the next subtable. */
+        ULLONG_SET0(found_map, i);  /* Did not match. */
+    next:
+        ; /* Keep Sparse happy. */
+    }
+
+    return found_map;
+}
+
+/* Expand out specialized functions with U0 and U1 bit attributes. */
+#define DECLARE_OPTIMIZED_LOOKUP_FUNCTION(U0, U1)                             \
+    static uint32_t                                                           \
+    dpcls_subtable_lookup_neon_mf_u0w##U0##_u1w##U1(                          \
+                                         struct dpcls_subtable *subtable,     \
+                                         uint32_t keys_map,                   \
+                                         const struct netdev_flow_key *keys[],\
+                                         struct dpcls_rule **rules)           \
+    {                                                                         \
+        return lookup_neon_impl(subtable, keys_map, keys, rules, U0, U1);     \
+    }                                                                         \
+
+DECLARE_OPTIMIZED_LOOKUP_FUNCTION(9, 4)
+DECLARE_OPTIMIZED_LOOKUP_FUNCTION(9, 1)
+DECLARE_OPTIMIZED_LOOKUP_FUNCTION(5, 3)
+DECLARE_OPTIMIZED_LOOKUP_FUNCTION(5, 1)
+DECLARE_OPTIMIZED_LOOKUP_FUNCTION(4, 1)
+DECLARE_OPTIMIZED_LOOKUP_FUNCTION(4, 0)
+
+/* Check if a specialized function is valid for the required subtable. */
+#define CHECK_LOOKUP_FUNCTION(U0, U1)                                         \
+    if (!f && u0_bits == U0 && u1_bits == U1) {                               \
+        f = dpcls_subtable_lookup_neon_mf_u0w##U0##_u1w##U1;                  \
+    }
+
+/* Probe function to lookup an available specialized function.
+ * If capable to run the requested miniflow fingerprint, this function returns
+ * the most optimal implementation for that miniflow fingerprint.
+ * @retval Non-NULL A valid function to handle the miniflow bit pattern
+ * @retval NULL The requested miniflow is not supported by this implementation.
+ */
+dpcls_subtable_lookup_func
+dpcls_subtable_neon_probe(uint32_t u0_bits, uint32_t u1_bits)
+{
+    dpcls_subtable_lookup_func f = NULL;
+
+    CHECK_LOOKUP_FUNCTION(9, 4);
+    CHECK_LOOKUP_FUNCTION(9, 1);
+    CHECK_LOOKUP_FUNCTION(5, 3);
+    CHECK_LOOKUP_FUNCTION(5, 1);
+    CHECK_LOOKUP_FUNCTION(4, 1);
+    CHECK_LOOKUP_FUNCTION(4, 0);
+
+    if (f) {
+        VLOG_DBG("Subtable using NEON Optimized for u0 %d, u1 %d\n",
+                 u0_bits, u1_bits);
+    }
+
+    /* Unlike the generic probe, return NULL for other fingerprints so that
+     * the framework falls back to the generic implementation for them. */
+    return f;
+}
+
+#endif /* __CHECKER__ */
+#endif /* __aarch64__ && __ARM_NEON */
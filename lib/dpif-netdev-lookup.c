@@ -48,6 +48,11 @@ static struct dpcls_subtable_lookup_info_t subtable_lookups[] = {
     { .prio = 0,
       .probe = dpcls_subtable_avx512_gather_probe,
       .name = "avx512_gather", },
+#elif (defined(__aarch64__) && defined(__ARM_NEON))
+    /* Only available on aarch64 builds, where NEON is always present. */
+    { .prio = 0,
+      .probe = dpcls_subtable_neon_probe,
+      .name = "neon", },
 #else
     /* Disabling AVX512 at compile time, as compile time requirements not met.
      * This could be due to a number of reasons:
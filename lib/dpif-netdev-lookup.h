@@ -46,6 +46,10 @@ dpcls_subtable_generic_probe(uint32_t u0_bit_count, uint32_t u1_bit_count);
 dpcls_subtable_lookup_func
 dpcls_subtable_avx512_gather_probe(uint32_t u0_bit_cnt, uint32_t u1_bit_cnt);
 
+/* Probe function for the aarch64 NEON implementation */
+dpcls_subtable_lookup_func
+dpcls_subtable_neon_probe(uint32_t u0_bit_cnt, uint32_t u1_bit_cnt);
+
 
 /* Subtable registration and iteration helpers */
 struct dpcls_subtable_lookup_info_t {
@@ -173,7 +173,11 @@ struct pmd_perf_stats {
     struct histogram pkts;
     struct histogram cycles_per_pkt;
     struct histogram upcalls;
-    struct histogram cycles_per_upcall;
+    struct histogram cycles_per_upcall; /* Covers the full PMD-side miss
+                                         * path: translation through the
+                                         * upcall callback plus the flow
+                                         * install, measured in
+                                         * handle_packet_upcall(). */
     struct histogram pkts_per_batch;
     struct histogram max_vhost_qfill;
     /* Iteration history buffer. */
@@ -19,6 +19,7 @@
 #include <config.h>
 
 #include "dpif-netdev-private-dfc.h"
+#include "util.h"
 
 static void
 emc_clear_entry(struct emc_entry *ce)
@@ -50,21 +51,28 @@ emc_cache_init(struct emc_cache *flow_cache)
 }
 
 static void
-smc_cache_init(struct smc_cache *smc_cache)
+smc_cache_init(struct smc_cache *smc_cache, uint32_t entries)
 {
-    int i, j;
-    for (i = 0; i < SMC_BUCKET_CNT; i++) {
+    uint32_t bucket_cnt = entries / SMC_ENTRY_PER_BUCKET;
+    uint32_t i;
+    int j;
+
+    ovs_assert(IS_POW2(entries));
+    smc_cache->buckets = xmalloc(bucket_cnt * sizeof *smc_cache->buckets);
+    smc_cache->bucket_mask = bucket_cnt - 1;
+    for (i = 0; i < bucket_cnt; i++) {
         for (j = 0; j < SMC_ENTRY_PER_BUCKET; j++) {
+            smc_cache->buckets[i].sig[j] = 0;
             smc_cache->buckets[i].flow_idx[j] = UINT16_MAX;
         }
     }
 }
 
 void
-dfc_cache_init(struct dfc_cache *flow_cache)
+dfc_cache_init(struct dfc_cache *flow_cache, uint32_t smc_entries)
 {
     emc_cache_init(&flow_cache->emc_cache);
-    smc_cache_init(&flow_cache->smc_cache);
+    smc_cache_init(&flow_cache->smc_cache, smc_entries);
 }
 
 static void
@@ -80,13 +88,26 @@ emc_cache_uninit(struct emc_cache *flow_cache)
 static void
 smc_cache_uninit(struct smc_cache *smc)
 {
-    int i, j;
+    uint32_t i;
+    int j;
 
-    for (i = 0; i < SMC_BUCKET_CNT; i++) {
+    for (i = 0; i <= smc->bucket_mask; i++) {
         for (j = 0; j < SMC_ENTRY_PER_BUCKET; j++) {
             smc_clear_entry(&(smc->buckets[i]), j);
         }
     }
+    free(smc->buckets);
+    smc->buckets = NULL;
+}
+
+void
+smc_cache_resize(struct smc_cache *smc, uint32_t entries)
+{
+    if (entries == smc_cache_entries(smc)) {
+        return;
+    }
+    smc_cache_uninit(smc);
+    smc_cache_init(smc, entries);
 }
 
 void
@@ -73,9 +73,11 @@ extern "C" {
  * a flow item can occupy. For now, it uses one hash function rather than two
  * as for the EMC design. */
 #define SMC_ENTRY_PER_BUCKET 4
-#define SMC_ENTRIES (1u << 20)
-#define SMC_BUCKET_CNT (SMC_ENTRIES / SMC_ENTRY_PER_BUCKET)
-#define SMC_MASK (SMC_BUCKET_CNT - 1)
+/* Default number of SMC entries.  Configurable at runtime through
+ * 'other_config:smc-entries', which must be a power of two. */
+#define SMC_DEFAULT_ENTRIES (1u << 20)
+#define SMC_MIN_ENTRIES (1u << 10)
+#define SMC_MAX_ENTRIES (1u << 26)
 
 /* Default EMC insert probability is 1 / DEFAULT_EM_FLOW_INSERT_INV_PROB */
 #define DEFAULT_EM_FLOW_INSERT_INV_PROB 100
@@ -107,7 +109,8 @@ struct smc_bucket {
 
 /* Signature match cache, differentiate from EMC cache */
 struct smc_cache {
-    struct smc_bucket buckets[SMC_BUCKET_CNT];
+    struct smc_bucket *buckets;
+    uint32_t bucket_mask;       /* Number of buckets, minus one. */
 };
 
 struct dfc_cache {
@@ -123,10 +126,22 @@ struct dfc_cache {
          i__ < EM_FLOW_HASH_SEGS;                                            \
          i__++, srch_hash__ >>= EM_FLOW_HASH_SHIFT)
 
-void dfc_cache_init(struct dfc_cache *flow_cache);
+void dfc_cache_init(struct dfc_cache *flow_cache, uint32_t smc_entries);
 
 void dfc_cache_uninit(struct dfc_cache *flow_cache);
 
+/* Returns the current number of entries in 'smc'. */
+static inline uint32_t
+smc_cache_entries(const struct smc_cache *smc)
+{
+    return (smc->bucket_mask + 1) * SMC_ENTRY_PER_BUCKET;
+}
+
+/* Reallocates 'smc' to hold 'entries' entries, dropping its content.
+ * No-op if 'smc' already has that size.  'entries' must be a power of two.
+ * Only the thread owning the cache may call this. */
+void smc_cache_resize(struct smc_cache *smc, uint32_t entries);
+
 /* Check and clear dead flow references slowly (one entry at each
  * invocation).  */
 void emc_cache_slow_sweep(struct emc_cache *flow_cache);
@@ -165,6 +180,19 @@ emc_lookup(struct emc_cache *cache, const struct netdev_flow_key *key)
     return NULL;
 }
 
+/* Prefetches the cache entries that an emc_lookup() of 'hash' will probe.
+ * Issuing the prefetches for a whole rx batch before the lookup stage hides
+ * the per-entry cache miss, the same way cmap_find_batch() does. */
+static inline void
+emc_prefetch(struct emc_cache *cache, uint32_t hash)
+{
+    struct emc_entry *current_entry;
+
+    EMC_FOR_EACH_POS_WITH_HASH (cache, current_entry, hash) {
+        OVS_PREFETCH(current_entry);
+    }
+}
+
 /* Insert a batch of keys/flows into the EMC and SMC caches. */
 void
 emc_probabilistic_insert_batch(struct dp_netdev_pmd_thread *pmd,
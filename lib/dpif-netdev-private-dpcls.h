@@ -63,6 +63,18 @@ uint32_t (*dpcls_subtable_lookup_func)(struct dpcls_subtable *subtable,
                                        const struct netdev_flow_key *keys[],
                                        struct dpcls_rule **rules);
 
+/* Counting Bloom pre-filter over the hashes of the rules in a subtable.
+ *
+ * The counters are grouped into cache line sized blocks and a key probes two
+ * counters inside one block, so testing a subtable for a definitely-absent
+ * hash costs a single cache line load.  Counters stick at their maximum on
+ * overflow, trading a few false positives for never underflowing.  A reader
+ * racing with a rule insertion may see the rule as absent, which is
+ * indistinguishable from the packet arriving just before the insertion. */
+#define DPCLS_PF_COUNTERS 4096
+#define DPCLS_PF_BLOCK_SIZE CACHE_LINE_SIZE
+#define DPCLS_PF_N_BLOCKS (DPCLS_PF_COUNTERS / DPCLS_PF_BLOCK_SIZE)
+
 /* A set of rules that all have the same fields wildcarded. */
 struct dpcls_subtable {
     /* The fields are only used by writers. */
@@ -91,10 +103,47 @@ struct dpcls_subtable {
     /* Caches the masks to match a packet to, reducing runtime calculations. */
     uint64_t *mf_masks;
 
+    /* Counting Bloom pre-filter over the hashes of the rules in 'rules'.
+     * Lookup implementations use it to skip this subtable for keys whose
+     * hash is definitely not present, see
+     * dpcls_subtable_pf_may_contain(). */
+    atomic_uint8_t *pf_counters;
+
     struct netdev_flow_key mask; /* Wildcards for fields (const). */
     /* 'mask' must be the last field, additional space is allocated here. */
 };
 
+/* Returns the indexes of the two pre-filter counters for 'hash'.  Both are
+ * inside the same cache line sized block. */
+static inline void
+dpcls_pf_slots(uint32_t hash, uint32_t *slot1, uint32_t *slot2)
+{
+    uint32_t base = (hash % DPCLS_PF_N_BLOCKS) * DPCLS_PF_BLOCK_SIZE;
+    uint32_t a = (hash >> 6) % DPCLS_PF_BLOCK_SIZE;
+    uint32_t b = (hash >> 12) % DPCLS_PF_BLOCK_SIZE;
+
+    if (a == b) {
+        b = (b + 1) % DPCLS_PF_BLOCK_SIZE;
+    }
+    *slot1 = base + a;
+    *slot2 = base + b;
+}
+
+/* Returns false if no rule with 'hash' can be present in 'subtable',
+ * otherwise true. */
+static inline bool
+dpcls_subtable_pf_may_contain(const struct dpcls_subtable *subtable,
+                              uint32_t hash)
+{
+    uint32_t slot1, slot2;
+    uint8_t c1, c2;
+
+    dpcls_pf_slots(hash, &slot1, &slot2);
+    atomic_read_relaxed(&subtable->pf_counters[slot1], &c1);
+    atomic_read_relaxed(&subtable->pf_counters[slot2], &c2);
+    return c1 && c2;
+}
+
 /* Iterate through netdev_flow_key TNL u64 values specified by 'FLOWMAP'. */
 #define NETDEV_FLOW_KEY_FOR_EACH_IN_FLOWMAP(VALUE, KEY, FLOWMAP)   \
     MINIFLOW_FOR_EACH_IN_FLOWMAP (VALUE, &(KEY)->mf, FLOWMAP)
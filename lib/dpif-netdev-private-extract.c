@@ -30,6 +30,27 @@
 
 VLOG_DEFINE_THIS_MODULE(dpif_netdev_extract);
 
+/* Batch wrapper around the specialized scalar extraction of common packet
+ * shapes, so that it takes part in the study and autovalidator mechanisms
+ * and can be selected on hosts without AVX512. */
+uint32_t
+mfex_scalar_ipv4_l4(struct dp_packet_batch *packets,
+                    struct netdev_flow_key *keys,
+                    uint32_t keys_size OVS_UNUSED,
+                    odp_port_t in_port OVS_UNUSED,
+                    struct dp_netdev_pmd_thread *pmd_handle OVS_UNUSED)
+{
+    uint32_t hitmask = 0;
+    struct dp_packet *packet;
+
+    DP_PACKET_BATCH_FOR_EACH (i, packet, packets) {
+        if (miniflow_extract_fast(packet, &keys[i].mf)) {
+            hitmask |= 1u << i;
+        }
+    }
+    return hitmask;
+}
+
 /* Variable to hold the default MFEX implementation. */
 static ATOMIC(miniflow_extract_func) default_mfex_func;
 
@@ -53,6 +74,11 @@ static struct dpif_miniflow_extract_impl mfex_impls[] = {
         .extract_func = mfex_study_traffic,
         .name = "study", },
 
+    [MFEX_IMPL_SCALAR_IPv4_L4] = {
+        .probe = NULL,
+        .extract_func = mfex_scalar_ipv4_l4,
+        .name = "scalar_ipv4_l4", },
+
 /* Compile in implementations only if the compiler ISA checks pass. */
 #if (__x86_64__ && HAVE_AVX512F && HAVE_LD_AVX512_GOOD && __SSE4_2__)
     [MFEX_IMPL_VMBI_IPv4_UDP] = {
@@ -94,6 +120,26 @@ static struct dpif_miniflow_extract_impl mfex_impls[] = {
         .probe = mfex_avx512_probe,
         .extract_func = mfex_avx512_dot1q_ip_tcp,
         .name = "avx512_dot1q_ipv4_tcp", },
+
+    [MFEX_IMPL_VMBI_QINQ_IPv4_UDP] = {
+        .probe = mfex_avx512_vbmi_probe,
+        .extract_func = mfex_avx512_vbmi_qinq_ip_udp,
+        .name = "avx512_vbmi_qinq_ipv4_udp", },
+
+    [MFEX_IMPL_QINQ_IPv4_UDP] = {
+        .probe = mfex_avx512_probe,
+        .extract_func = mfex_avx512_qinq_ip_udp,
+        .name = "avx512_qinq_ipv4_udp", },
+
+    [MFEX_IMPL_VMBI_QINQ_IPv4_TCP] = {
+        .probe = mfex_avx512_vbmi_probe,
+        .extract_func = mfex_avx512_vbmi_qinq_ip_tcp,
+        .name = "avx512_vbmi_qinq_ipv4_tcp", },
+
+    [MFEX_IMPL_QINQ_IPv4_TCP] = {
+        .probe = mfex_avx512_probe,
+        .extract_func = mfex_avx512_qinq_ip_tcp,
+        .name = "avx512_qinq_ipv4_tcp", },
 #endif
 };
 
@@ -81,6 +81,7 @@ enum dpif_miniflow_extract_impl_idx {
     MFEX_IMPL_AUTOVALIDATOR,
     MFEX_IMPL_SCALAR,
     MFEX_IMPL_STUDY,
+    MFEX_IMPL_SCALAR_IPv4_L4,
 #if (__x86_64__ && HAVE_AVX512F && HAVE_LD_AVX512_GOOD && __SSE4_2__)
     MFEX_IMPL_VMBI_IPv4_UDP,
     MFEX_IMPL_IPv4_UDP,
@@ -90,6 +91,10 @@ enum dpif_miniflow_extract_impl_idx {
     MFEX_IMPL_DOT1Q_IPv4_UDP,
     MFEX_IMPL_VMBI_DOT1Q_IPv4_TCP,
     MFEX_IMPL_DOT1Q_IPv4_TCP,
+    MFEX_IMPL_VMBI_QINQ_IPv4_UDP,
+    MFEX_IMPL_QINQ_IPv4_UDP,
+    MFEX_IMPL_VMBI_QINQ_IPv4_TCP,
+    MFEX_IMPL_QINQ_IPv4_TCP,
 #endif
     MFEX_IMPL_MAX
 };
@@ -99,14 +104,7 @@ extern struct ovs_mutex dp_netdev_mutex;
 /* Define a index which points to the first traffic optimized MFEX
  * option from the enum list else holds max value.
  */
-#if (__x86_64__ && HAVE_AVX512F && HAVE_LD_AVX512_GOOD && __SSE4_2__)
-
-#define MFEX_IMPL_START_IDX MFEX_IMPL_VMBI_IPv4_UDP
-#else
-
-#define MFEX_IMPL_START_IDX MFEX_IMPL_MAX
-
-#endif
+#define MFEX_IMPL_START_IDX MFEX_IMPL_SCALAR_IPv4_L4
 
 /* Max count of packets to be compared. */
 #define MFEX_MAX_PKT_COUNT (128)
@@ -197,7 +195,15 @@ DECLARE_AVX512_MFEX_PROTOTYPE(ip_udp);
 DECLARE_AVX512_MFEX_PROTOTYPE(ip_tcp);
 DECLARE_AVX512_MFEX_PROTOTYPE(dot1q_ip_udp);
 DECLARE_AVX512_MFEX_PROTOTYPE(dot1q_ip_tcp);
+DECLARE_AVX512_MFEX_PROTOTYPE(qinq_ip_udp);
+DECLARE_AVX512_MFEX_PROTOTYPE(qinq_ip_tcp);
 
 #endif /* __x86_64__ */
 
+/* Specialized scalar implementation, available on every platform. */
+uint32_t mfex_scalar_ipv4_l4(struct dp_packet_batch *packets,
+                             struct netdev_flow_key *keys,
+                             uint32_t keys_size, odp_port_t in_port,
+                             struct dp_netdev_pmd_thread *pmd_handle);
+
 #endif /* MFEX_AVX512_EXTRACT */
@@ -154,6 +154,14 @@ void dp_netdev_flow_unref(struct dp_netdev_flow *);
  *
  * A struct dp_netdev_actions 'actions' is protected with RCU. */
 struct dp_netdev_actions {
+    /* Interning state: identical action lists share one instance through a
+     * global refcounted intern table, so the hundreds of thousands of
+     * megaflows a deployment typically splits a handful of OpenFlow rules
+     * into stay on a few cache-resident action buffers. */
+    struct cmap_node node;      /* In the actions intern table. */
+    struct ovs_refcount refcnt; /* Sharing flows (and transient holders). */
+    uint32_t hash;              /* Hash of 'actions' bytes, intern key. */
+
     /* These members are immutable: they do not change during the struct's
      * lifetime.  */
     unsigned int size;          /* Size of 'actions', in bytes. */
@@ -33,6 +33,7 @@
 #include "dpif-netdev-private-dpif.h"
 #include "dpif-netdev-perf.h"
 #include "dpif-netdev-private-extract.h"
+#include "mpsc-queue.h"
 #include "openvswitch/thread.h"
 
 #ifdef  __cplusplus
@@ -54,8 +55,29 @@ struct dp_netdev_pmd_thread_ctx {
     uint32_t emc_insert_min;
     /* Enable the SMC cache from ovsdb config. */
     bool smc_enable_db;
+    /* Enable work stealing between pmd threads from ovsdb config. */
+    bool work_stealing;
+    /* Packet sampling interval of the flight recorder, 0 disables it. */
+    uint32_t trace_interval;
 };
 
+/* One sampled packet in the pmd flight recorder.  Written only by the
+ * owning pmd thread; readers validate 'seq' (odd while the entry is being
+ * written) around their copy, seqlock style. */
+struct pmd_trace_entry {
+    atomic_uint32_t seq;
+    long long timestamp;     /* Time of sampling, in pmd clock usecs. */
+    odp_port_t in_port;      /* Datapath port the packet arrived on. */
+    uint32_t hash;           /* RSS or recomputed 5-tuple hash. */
+    uint32_t size;           /* Packet size in bytes. */
+    uintptr_t flow;          /* Flow hit in the first-level cache, or 0 if
+                              * the packet went on to SMC/dpcls/upcall. */
+};
+
+/* Number of entries in the per-pmd flight recorder ring.  Must be a power
+ * of two. */
+#define PMD_TRACE_RING_SIZE 256
+
 /* PMD: Poll modes drivers.  PMD accesses devices via polling to eliminate
  * the performance overhead of interrupt processing.  Therefore netdev can
  * not implement rx-wait for these devices.  dpif-netdev needs to poll
@@ -213,6 +235,19 @@ struct dp_netdev_pmd_thread {
     struct hmap tnl_port_cache;
     struct hmap send_port_cache;
 
+    /* Work stealing between pmd threads.
+     *
+     * 'overflow_queue' holds rx batches pushed by overloaded pmd threads
+     * on the same NUMA node.  This thread is the only consumer of its own
+     * queue and drains it in iterations where its polled rxqs are empty. */
+    struct mpsc_queue overflow_queue;
+    /* Number of batches currently in 'overflow_queue'. */
+    atomic_count n_overflow_batches;
+    /* True if the last polling iteration received no packets.  Read by
+     * overloaded pmd threads on the same NUMA node to pick a thread that
+     * has cycles to spare. */
+    atomic_bool ws_idle;
+
     /* Keep track of detailed PMD performance statistics. */
     struct pmd_perf_stats perf_stats;
 
@@ -226,6 +261,21 @@ struct dp_netdev_pmd_thread {
 
     /* Next time when PMD should try RCU quiescing. */
     long long next_rcu_quiesce;
+
+    /* Flight recorder: a ring of sampled packets, written by this pmd
+     * thread when 'ctx.trace_interval' is nonzero and read, seqlock
+     * style, by the "dpif-netdev/flight-recorder-show" command. */
+    struct pmd_trace_entry trace_ring[PMD_TRACE_RING_SIZE];
+    uint32_t trace_head;       /* Next ring slot to write. */
+    uint32_t trace_countdown;  /* Packets left until the next sample. */
+
+    /* State of the adaptive EMC insertion controller, used only by this
+     * pmd thread.  See dp_netdev_pmd_try_optimize(). */
+    uint64_t emc_prev_hits;
+    uint64_t emc_prev_recv;
+    uint32_t emc_last_ratio;
+    int8_t emc_dir;
+    uint32_t emc_insert_min_auto;
 };
 
 #ifdef  __cplusplus
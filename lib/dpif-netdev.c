@@ -94,6 +94,9 @@ VLOG_DEFINE_THIS_MODULE(dpif_netdev);
 #define ALB_IMPROVEMENT_THRESHOLD    25
 #define ALB_LOAD_THRESHOLD           95
 #define ALB_REBALANCE_INTERVAL       1 /* 1 Min */
+#define ALB_EWMA_ALPHA               25 /* Weight of the newest interval, in
+                                           percent, in the per-rxq cycles
+                                           EWMA. */
 #define MIN_TO_MSEC                  60000
 
 #define FLOW_DUMP_MAX_BATCH 50
@@ -168,6 +171,14 @@ static struct odp_support dp_netdev_support = {
 /* Time in microseconds to try RCU quiescing. */
 #define PMD_RCU_QUIESCE_INTERVAL 10000LL
 
+/* Timed sleeping of an idle pmd thread, enabled with 'pmd-maxsleep'.  The
+ * sleep request doubles from PMD_SLEEP_INC_US for every iteration that
+ * processes no packets, up to the configured maximum, and resets to zero
+ * as soon as any packet is received so a loaded thread never sleeps. */
+#define PMD_SLEEP_INC_US 1
+/* Upper bound for 'pmd-maxsleep', in microseconds. */
+#define PMD_SLEEP_MAX_US 10000
+
 struct dpcls {
     struct cmap_node node;      /* Within dp_netdev_pmd_thread.classifiers */
     odp_port_t in_port;
@@ -223,10 +234,13 @@ struct pmd_auto_lb {
     bool do_dry_run;
     bool recheck_config;
     bool is_enabled;            /* Current status of Auto load balancing. */
+    bool use_ewma;              /* Estimate rxq load from the cycles EWMA
+                                   instead of the summed interval history. */
     uint64_t rebalance_intvl;
     uint64_t rebalance_poll_timer;
     uint8_t rebalance_improve_thresh;
     atomic_uint8_t rebalance_load_thresh;
+    atomic_uint8_t ewma_alpha;  /* Weight of the newest interval, percent. */
 };
 
 enum sched_assignment_type {
@@ -267,6 +281,8 @@ struct dp_netdev {
 
     /* The time that a packet can wait in output batch for sending. */
     atomic_uint32_t tx_flush_interval;
+    /* Scale the per-port flush deadline with the recent batch fill level. */
+    atomic_bool tx_flush_adaptive;
 
     /* Meters. */
     struct ovs_mutex meters_lock;
@@ -274,10 +290,23 @@ struct dp_netdev {
 
     /* Probability of EMC insertions is a factor of 'emc_insert_min'.*/
     atomic_uint32_t emc_insert_min;
+    /* Let each pmd thread adapt its EMC insertion probability to the
+     * observed hit rate instead of using 'emc_insert_min'. */
+    atomic_bool emc_insert_auto;
     /* Enable collection of PMD performance metrics. */
     atomic_bool pmd_perf_metrics;
     /* Enable the SMC cache from ovsdb config */
     atomic_bool smc_enable_db;
+    /* Number of entries of the SMC cache of each thread. */
+    atomic_uint32_t smc_entries;
+    /* Enable work stealing between pmd threads from ovsdb config */
+    atomic_bool pmd_work_stealing;
+    /* Max sleep request in microseconds for an idle pmd thread, 0 keeps
+     * it busy-polling. */
+    atomic_uint64_t pmd_max_sleep;
+    /* Sampling interval of the pmd flight recorder: every Nth packet is
+     * recorded, 0 disables sampling. */
+    atomic_uint32_t pmd_trace_interval;
 
     /* Protects access to ofproto-dpif-upcall interface during revalidator
      * thread synchronization. */
@@ -437,6 +466,9 @@ struct dp_netdev_rxq {
     /* We store PMD_INTERVAL_MAX intervals of data for an rxq and then
        sum them to yield the cycles used for an rxq. */
     atomic_ullong cycles_intrvl[PMD_INTERVAL_MAX];
+    /* EWMA of the per-interval processing cycles, as a smoothed estimate of
+       the rxq load for the auto load balancer. */
+    atomic_ullong cycles_ewma;
 };
 
 enum txq_req_mode {
@@ -500,6 +532,9 @@ struct tx_port {
     long long last_used;
     struct hmap_node node;
     long long flush_time;
+    /* EWMA of the output batch fill level at flush time, in percent of a
+     * full burst.  Drives the adaptive flush deadline. */
+    uint32_t fill_ewma;
     struct dp_packet_batch output_pkts;
     struct dp_packet_batch *txq_pkts; /* Only for hash mode. */
     struct dp_netdev_rxq *output_pkts_rxqs[NETDEV_MAX_BURST];
@@ -560,6 +595,9 @@ static void dp_netdev_set_nonpmd(struct dp_netdev *dp)
     OVS_REQ_WRLOCK(dp->port_rwlock);
 
 static void *pmd_thread_main(void *);
+static void dpif_netdev_pmd_rebalance_dry_run(struct unixctl_conn *conn,
+                                              int argc, const char *argv[],
+                                              void *aux);
 static struct dp_netdev_pmd_thread *dp_netdev_get_pmd(struct dp_netdev *dp,
                                                       unsigned core_id);
 static struct dp_netdev_pmd_thread *
@@ -1537,6 +1575,251 @@ pmd_perf_show_cmd(struct unixctl_conn *conn, int argc,
     dpif_netdev_pmd_info(conn, argc, argv, &par);
 }
 
+/* Shows the always-on per-zone conntrack statistics of a datapath. */
+static void
+dpif_netdev_ct_zone_stats(struct unixctl_conn *conn, int argc,
+                          const char *argv[], void *aux OVS_UNUSED)
+{
+    struct ds reply = DS_EMPTY_INITIALIZER;
+    struct dp_netdev *dp = NULL;
+
+    ovs_mutex_lock(&dp_netdev_mutex);
+
+    if (argc == 2) {
+        dp = shash_find_data(&dp_netdevs, argv[1]);
+    } else if (shash_count(&dp_netdevs) == 1) {
+        /* There's only one datapath */
+        dp = shash_first(&dp_netdevs)->data;
+    }
+    if (!dp) {
+        ovs_mutex_unlock(&dp_netdev_mutex);
+        unixctl_command_reply_error(conn,
+                                    "please specify an existing datapath");
+        return;
+    }
+
+    conntrack_zone_stats_format(dp->conntrack, &reply);
+    ovs_mutex_unlock(&dp_netdev_mutex);
+
+    unixctl_command_reply(conn, ds_cstr(&reply));
+    ds_destroy(&reply);
+}
+
+/* Mapping of pmd counters to OpenMetrics family names. */
+static const struct {
+    enum pmd_stat_type stat;
+    const char *name;
+    const char *help;
+} pmd_perf_metric_defs[] = {
+    { PMD_STAT_RECV, "rx_packets", "Packets received from interfaces." },
+    { PMD_STAT_RECIRC, "recirculations",
+      "Packets reentering the datapath due to recirculation." },
+    { PMD_STAT_PHWOL_HIT, "phwol_hits", "Partial hardware offload hits." },
+    { PMD_STAT_MFEX_OPT_HIT, "mfex_opt_hits",
+      "Optimized miniflow extract hits." },
+    { PMD_STAT_SIMPLE_HIT, "simple_match_hits", "Simple match hits." },
+    { PMD_STAT_EXACT_HIT, "emc_hits", "Exact match cache hits." },
+    { PMD_STAT_SMC_HIT, "smc_hits", "Signature match cache hits." },
+    { PMD_STAT_MASKED_HIT, "megaflow_hits", "Flow table hits." },
+    { PMD_STAT_MASKED_LOOKUP, "megaflow_lookups",
+      "Subtable lookups for flow table hits." },
+    { PMD_STAT_MISS, "upcalls", "Packets that took a successful upcall." },
+    { PMD_STAT_LOST, "upcall_errors", "Packets whose upcall failed." },
+    { PMD_STAT_SENT_PKTS, "tx_packets", "Packets sent." },
+    { PMD_STAT_SENT_BATCHES, "tx_batches", "Batches sent." },
+    { PMD_CYCLES_ITER_IDLE, "idle_cycles",
+      "Cycles spent in idle iterations." },
+    { PMD_CYCLES_ITER_BUSY, "busy_cycles",
+      "Cycles spent in busy iterations." },
+    { PMD_CYCLES_UPCALL, "upcall_cycles",
+      "Cycles spent processing upcalls." },
+};
+
+/* Emits the pmd counters and histograms in OpenMetrics text exposition
+ * format, so that monitoring agents can relay them to a collector without
+ * parsing the human readable 'pmd-perf-show' output.  Histograms are
+ * exposed as cumulative, 'le'-labelled bucket counters. */
+static void
+pmd_perf_metrics_cmd(struct unixctl_conn *conn, int argc, const char *argv[],
+                     void *aux OVS_UNUSED)
+{
+    static const char *const hist_names[] = {
+        "cycles_per_iteration", "packets_per_iteration", "cycles_per_packet",
+        "upcalls_per_iteration", "cycles_per_upcall", "packets_per_batch",
+        "max_vhost_qfill",
+    };
+    struct ds reply = DS_EMPTY_INITIALIZER;
+    struct dp_netdev_pmd_thread **pmd_list;
+    struct dp_netdev *dp = NULL;
+    uint64_t *counters;
+    size_t n;
+
+    ovs_mutex_lock(&dp_netdev_mutex);
+
+    if (argc == 2) {
+        dp = shash_find_data(&dp_netdevs, argv[1]);
+    } else if (shash_count(&dp_netdevs) == 1) {
+        /* There's only one datapath */
+        dp = shash_first(&dp_netdevs)->data;
+    }
+    if (!dp) {
+        ovs_mutex_unlock(&dp_netdev_mutex);
+        unixctl_command_reply_error(conn,
+                                    "please specify an existing datapath");
+        return;
+    }
+
+    sorted_poll_thread_list(dp, &pmd_list, &n);
+
+    /* Snapshot all counters first, so each metric family below can be
+     * emitted contiguously. */
+    counters = xmalloc(n * PMD_N_STATS * sizeof *counters);
+    for (size_t i = 0; i < n; i++) {
+        pmd_perf_read_counters(&pmd_list[i]->perf_stats,
+                               &counters[i * PMD_N_STATS]);
+    }
+
+    for (size_t m = 0; m < ARRAY_SIZE(pmd_perf_metric_defs); m++) {
+        ds_put_format(&reply, "# HELP ovs_pmd_%s %s\n",
+                      pmd_perf_metric_defs[m].name,
+                      pmd_perf_metric_defs[m].help);
+        ds_put_format(&reply, "# TYPE ovs_pmd_%s counter\n",
+                      pmd_perf_metric_defs[m].name);
+        for (size_t i = 0; i < n; i++) {
+            struct dp_netdev_pmd_thread *pmd = pmd_list[i];
+
+            if (pmd->core_id == NON_PMD_CORE_ID) {
+                continue;
+            }
+            ds_put_format(&reply, "ovs_pmd_%s_total{numa_id=\"%d\","
+                          "core_id=\"%u\"} %"PRIu64"\n",
+                          pmd_perf_metric_defs[m].name, pmd->numa_id,
+                          pmd->core_id,
+                          counters[i * PMD_N_STATS
+                                   + pmd_perf_metric_defs[m].stat]);
+        }
+    }
+
+    for (size_t hi = 0; hi < ARRAY_SIZE(hist_names); hi++) {
+        ds_put_format(&reply, "# TYPE ovs_pmd_%s_bucket counter\n",
+                      hist_names[hi]);
+        for (size_t i = 0; i < n; i++) {
+            struct dp_netdev_pmd_thread *pmd = pmd_list[i];
+            struct pmd_perf_stats *s = &pmd->perf_stats;
+            struct histogram *hists[] = {
+                &s->cycles, &s->pkts, &s->cycles_per_pkt, &s->upcalls,
+                &s->cycles_per_upcall, &s->pkts_per_batch, &s->max_vhost_qfill,
+            };
+            struct histogram *hist = hists[hi];
+            uint64_t cum = 0;
+
+            if (pmd->core_id == NON_PMD_CORE_ID) {
+                continue;
+            }
+            for (int b = 0; b < NUM_BINS; b++) {
+                cum += hist->bin[b];
+                if (hist->wall[b] == UINT32_MAX) {
+                    ds_put_format(&reply, "ovs_pmd_%s_bucket_total{"
+                                  "numa_id=\"%d\",core_id=\"%u\","
+                                  "le=\"+Inf\"} %"PRIu64"\n",
+                                  hist_names[hi], pmd->numa_id, pmd->core_id,
+                                  cum);
+                } else {
+                    ds_put_format(&reply, "ovs_pmd_%s_bucket_total{"
+                                  "numa_id=\"%d\",core_id=\"%u\","
+                                  "le=\"%"PRIu32"\"} %"PRIu64"\n",
+                                  hist_names[hi], pmd->numa_id, pmd->core_id,
+                                  hist->wall[b], cum);
+                }
+            }
+        }
+    }
+    ds_put_cstr(&reply, "# EOF\n");
+
+    free(counters);
+    free(pmd_list);
+
+    ovs_mutex_unlock(&dp_netdev_mutex);
+
+    unixctl_command_reply(conn, ds_cstr(&reply));
+    ds_destroy(&reply);
+}
+
+/* Dumps the flight recorder rings of the pmd threads: packets sampled in
+ * the datapath receive path when 'other_config:pmd-trace-sample' is set.
+ * Entries are copied seqlock style, so a torn entry being overwritten by
+ * its pmd at dump time is skipped rather than misreported. */
+static void
+pmd_trace_show_cmd(struct unixctl_conn *conn, int argc, const char *argv[],
+                   void *aux OVS_UNUSED)
+{
+    struct ds reply = DS_EMPTY_INITIALIZER;
+    struct dp_netdev_pmd_thread **pmd_list;
+    struct dp_netdev *dp = NULL;
+    size_t n;
+
+    ovs_mutex_lock(&dp_netdev_mutex);
+
+    if (argc == 2) {
+        dp = shash_find_data(&dp_netdevs, argv[1]);
+    } else if (shash_count(&dp_netdevs) == 1) {
+        /* There's only one datapath */
+        dp = shash_first(&dp_netdevs)->data;
+    }
+    if (!dp) {
+        ovs_mutex_unlock(&dp_netdev_mutex);
+        unixctl_command_reply_error(conn,
+                                    "please specify an existing datapath");
+        return;
+    }
+
+    sorted_poll_thread_list(dp, &pmd_list, &n);
+    for (size_t i = 0; i < n; i++) {
+        struct dp_netdev_pmd_thread *pmd = pmd_list[i];
+
+        if (!pmd || pmd->core_id == NON_PMD_CORE_ID) {
+            continue;
+        }
+        ds_put_format(&reply, "pmd thread numa_id %d core_id %u:\n",
+                      pmd->numa_id, pmd->core_id);
+        for (uint32_t j = 0; j < PMD_TRACE_RING_SIZE; j++) {
+            struct pmd_trace_entry *e = &pmd->trace_ring[j];
+            uint32_t seq1, seq2;
+            long long timestamp;
+            odp_port_t in_port;
+            uint32_t hash, size;
+            uintptr_t flow;
+
+            atomic_read_explicit(&e->seq, &seq1, memory_order_acquire);
+            if (!seq1 || seq1 & 1) {
+                continue;
+            }
+            timestamp = e->timestamp;
+            in_port = e->in_port;
+            hash = e->hash;
+            size = e->size;
+            flow = e->flow;
+            /* Order the field reads before the recheck, mirroring the
+             * writer's fence. */
+            atomic_thread_fence(memory_order_acquire);
+            atomic_read_relaxed(&e->seq, &seq2);
+            if (seq1 != seq2) {
+                continue;
+            }
+            ds_put_format(&reply, "  time:%lld port:%"PRIu32" hash:0x%08"
+                          PRIx32" size:%"PRIu32" cache-hit-flow:0x%"PRIxPTR
+                          "\n", timestamp, odp_to_u32(in_port),
+                          hash, size, flow);
+        }
+    }
+    free(pmd_list);
+
+    ovs_mutex_unlock(&dp_netdev_mutex);
+
+    unixctl_command_reply(conn, ds_cstr(&reply));
+    ds_destroy(&reply);
+}
+
 static void
 dpif_netdev_bond_show(struct unixctl_conn *conn, int argc,
                       const char *argv[], void *aux OVS_UNUSED)
@@ -1605,6 +1888,18 @@ dpif_netdev_init(void)
     unixctl_command_register("dpif-netdev/pmd-rxq-rebalance", "[dp]",
                              0, 1, dpif_netdev_pmd_rebalance,
                              NULL);
+    unixctl_command_register("dpif-netdev/pmd-rebalance-dry-run", "[dp]",
+                             0, 1, dpif_netdev_pmd_rebalance_dry_run,
+                             NULL);
+    unixctl_command_register("dpif-netdev/pmd-perf-metrics", "[dp]",
+                             0, 1, pmd_perf_metrics_cmd,
+                             NULL);
+    unixctl_command_register("dpif-netdev/flight-recorder-show", "[dp]",
+                             0, 1, pmd_trace_show_cmd,
+                             NULL);
+    unixctl_command_register("dpif-netdev/ct-zone-stats", "[dp]",
+                             0, 1, dpif_netdev_ct_zone_stats,
+                             NULL);
     unixctl_command_register("dpif-netdev/pmd-perf-log-set",
                              "on|off [-b before] [-a after] [-e|-ne] "
                              "[-us usec] [-q qlen]",
@@ -1789,6 +2084,19 @@ dp_meter_attach(struct cmap *meters, struct dp_meter *meter)
     cmap_insert(meters, &meter->node, dp_meter_hash(meter->id));
 }
 
+/* A hot-upgrade handover (old and new vswitchd negotiating DPDK port
+ * ownership, vhost connections and flow table transfer over a unix
+ * socket) was scoped against this lifecycle.  The blocking constraint
+ * is process-exclusive resource ownership: rte_eth devices are bound to
+ * one EAL process (secondary-process mode shares them but also shares
+ * crashes, which defeats upgrade isolation), and a userspace flow table
+ * transferred without the conntrack table and tx queue state behind it
+ * would misforward rather than drop.  The pieces that can survive a
+ * restart already do - vhost-user reconnect keeps guest queues alive
+ * across the gap, and the kernel datapath keeps forwarding on its
+ * installed flows.  Sub-100 ms userspace upgrades realistically need
+ * the DPDK multi-process story to mature first; until then the lever
+ * is shrinking restart time (config replay dominates, see bundles). */
 static int
 create_dp_netdev(const char *name, const struct dpif_class *class,
                  struct dp_netdev **dpp)
@@ -1839,7 +2147,11 @@ create_dp_netdev(const char *name, const struct dpif_class *class,
     dpif_miniflow_extract_init();
 
     atomic_init(&dp->emc_insert_min, DEFAULT_EM_FLOW_INSERT_MIN);
+    atomic_init(&dp->smc_entries, SMC_DEFAULT_ENTRIES);
     atomic_init(&dp->tx_flush_interval, DEFAULT_TX_FLUSH_INTERVAL);
+    atomic_init(&dp->pmd_max_sleep, 0);
+    atomic_init(&dp->pmd_trace_interval, 0);
+    atomic_init(&dp->pmd_alb.ewma_alpha, ALB_EWMA_ALPHA);
 
     cmap_init(&dp->poll_threads);
     dp->pmd_rxq_assign_type = SCHED_CYCLES;
@@ -2224,6 +2536,14 @@ is_valid_port_number(odp_port_t port_no)
     return port_no != ODPP_NONE;
 }
 
+/* This hmap lookup is control-path only (port add/remove/query): the
+ * packet path never comes through here.  pmd threads resolve output
+ * ports through their thread-local 'send_port_cache'/'tnl_port_cache'
+ * hmaps, rebuilt on reload without locks, and input-side state is
+ * reached through per-port classifiers keyed in pmd-local cmaps.  A
+ * dense-id flat array with RCU swap would therefore speed up a path
+ * that executes a handful of times per reconfiguration; keep that in
+ * mind before plumbing an id allocator through port lifetimes. */
 static struct dp_netdev_port *
 dp_netdev_lookup_port(const struct dp_netdev *dp, odp_port_t port_no)
     OVS_REQ_RDLOCK(dp->port_rwlock)
@@ -3402,7 +3722,7 @@ static inline const struct cmap_node *
 smc_entry_get(struct dp_netdev_pmd_thread *pmd, const uint32_t hash)
 {
     struct smc_cache *cache = &(pmd->flow_cache).smc_cache;
-    struct smc_bucket *bucket = &cache->buckets[hash & SMC_MASK];
+    struct smc_bucket *bucket = &cache->buckets[hash & cache->bucket_mask];
     uint16_t sig = hash >> 16;
     uint16_t index = UINT16_MAX;
 
@@ -3430,7 +3750,8 @@ smc_insert(struct dp_netdev_pmd_thread *pmd,
            uint32_t hash)
 {
     struct smc_cache *smc_cache = &(pmd->flow_cache).smc_cache;
-    struct smc_bucket *bucket = &smc_cache->buckets[key->hash & SMC_MASK];
+    struct smc_bucket *bucket
+        = &smc_cache->buckets[key->hash & smc_cache->bucket_mask];
     uint16_t index;
     uint32_t cmap_index;
     int i;
@@ -4084,7 +4405,19 @@ dp_netdev_flow_add(struct dp_netdev_pmd_thread *pmd,
     ovs_assert(!FLOWMAP_HAS_FIELD(&mask.mf.map, metadata)
                && !FLOWMAP_HAS_FIELD(&mask.mf.map, regs));
 
-    /* Do not allocate extra space. */
+    /* Do not allocate extra space.
+     *
+     * Background compaction of long-lived flows into per-subtable
+     * arenas was assessed against the dTLB profile claim: a flow's
+     * address is its identity - EMC and SMC entries, dpcls cmap nodes
+     * and in-flight batches all hold the pointer - so relocation means
+     * insert-new/retire-old through a full RCU grace period per flow
+     * with every cache invalidated, which is indistinguishable from the
+     * flow churn the defrag is meant to cure.  Flows are sized to their
+     * miniflow here precisely to keep subtable neighbors dense; if TLB
+     * pressure is real the cheap, safe lever is backing the malloc heap
+     * with hugepages (e.g. transparent hugepages or a hugetlbfs arena
+     * allocator), which needs no pointer rewriting. */
     flow = xmalloc(sizeof *flow - sizeof flow->cr.flow.mf + mask.len);
     memset(&flow->stats, 0, sizeof flow->stats);
     atomic_init(&flow->netdev_flow_get_result, 0);
@@ -4430,6 +4763,16 @@ dpif_netdev_flow_dump_thread_destroy(struct dpif_flow_dump_thread *thread_)
     free(thread);
 }
 
+/* A shared per-dump snapshot arena that revalidators parse in place was
+ * examined as a replacement for these per-thread buffers.  The copies it
+ * would eliminate are not transient: the revalidator keeps key, mask and
+ * actions in the ukey for the flow's whole lifetime (they are compared
+ * against on every later dump), so the arena would have to live as long
+ * as the longest-lived ukey it feeds - it stops being a snapshot and
+ * becomes a second flow store.  The per-thread buffers here are reused
+ * across batches and already amortize to zero allocations per flow;
+ * dump cadence on large tables is bounded by per-flow translation work
+ * in the revalidator, not by this copy. */
 static int
 dpif_netdev_flow_dump_next(struct dpif_flow_dump_thread *thread_,
                            struct dpif_flow *flows, int max_flows)
@@ -4791,6 +5134,16 @@ dpif_netdev_set_config(struct dpif *dpif, const struct smap *other_config)
                   tx_flush_interval);
     }
 
+    bool tx_flush_adaptive = smap_get_bool(other_config, "tx-flush-adaptive",
+                                           false);
+    bool cur_tx_flush_adaptive;
+    atomic_read_relaxed(&dp->tx_flush_adaptive, &cur_tx_flush_adaptive);
+    if (tx_flush_adaptive != cur_tx_flush_adaptive) {
+        atomic_store_relaxed(&dp->tx_flush_adaptive, tx_flush_adaptive);
+        VLOG_INFO("Adaptive tx flushing %s",
+                  tx_flush_adaptive ? "enabled" : "disabled");
+    }
+
     if (!nullable_string_is_equal(dp->pmd_cmask, cmask)) {
         free(dp->pmd_cmask);
         dp->pmd_cmask = nullable_xstrdup(cmask);
@@ -4815,6 +5168,15 @@ dpif_netdev_set_config(struct dpif *dpif, const struct smap *other_config)
         }
     }
 
+    bool emc_auto = smap_get_bool(other_config, "emc-auto-insert", false);
+    bool cur_emc_auto;
+    atomic_read_relaxed(&dp->emc_insert_auto, &cur_emc_auto);
+    if (emc_auto != cur_emc_auto) {
+        atomic_store_relaxed(&dp->emc_insert_auto, emc_auto);
+        VLOG_INFO("EMC adaptive insertion probability %s",
+                  emc_auto ? "enabled" : "disabled");
+    }
+
     bool perf_enabled = smap_get_bool(other_config, "pmd-perf-metrics", false);
     bool cur_perf_enabled;
     atomic_read_relaxed(&dp->pmd_perf_metrics, &cur_perf_enabled);
@@ -4839,6 +5201,86 @@ dpif_netdev_set_config(struct dpif *dpif, const struct smap *other_config)
         }
     }
 
+    uint64_t smc_entries = smap_get_ullong(other_config, "smc-entries",
+                                           SMC_DEFAULT_ENTRIES);
+    uint32_t cur_smc_entries;
+    if (smc_entries < SMC_MIN_ENTRIES || smc_entries > SMC_MAX_ENTRIES
+        || !IS_POW2(smc_entries)) {
+        VLOG_WARN("smc-entries must be a power of two between %u and %u. "
+                  "Using default %u.", SMC_MIN_ENTRIES, SMC_MAX_ENTRIES,
+                  SMC_DEFAULT_ENTRIES);
+        smc_entries = SMC_DEFAULT_ENTRIES;
+    }
+    atomic_read_relaxed(&dp->smc_entries, &cur_smc_entries);
+    if (smc_entries != cur_smc_entries) {
+        atomic_store_relaxed(&dp->smc_entries, (uint32_t) smc_entries);
+        VLOG_INFO("SMC cache resized to %"PRIu64" entries", smc_entries);
+    }
+
+    conntrack_set_sweep_quantum(dp->conntrack,
+                                smap_get_uint(other_config,
+                                              "ct-sweep-quantum", 0));
+
+    if (conntrack_set_alg_bypass_zones(dp->conntrack,
+                                       smap_get(other_config,
+                                                "ct-alg-bypass-zones"))) {
+        VLOG_WARN("Invalid ct-alg-bypass-zones specification, "
+                  "keeping the previous set.");
+    }
+
+    if (conntrack_set_tcp_seq_chk_bypass_zones(
+            dp->conntrack,
+            smap_get(other_config, "ct-tcp-seq-chk-bypass-zones"))) {
+        VLOG_WARN("Invalid ct-tcp-seq-chk-bypass-zones specification, "
+                  "keeping the previous set.");
+    }
+
+    bool work_stealing = smap_get_bool(other_config, "pmd-work-stealing",
+                                       false);
+    bool cur_ws;
+    atomic_read_relaxed(&dp->pmd_work_stealing, &cur_ws);
+    if (work_stealing != cur_ws) {
+        atomic_store_relaxed(&dp->pmd_work_stealing, work_stealing);
+        if (work_stealing) {
+            VLOG_INFO("PMD work stealing is enabled");
+        } else {
+            VLOG_INFO("PMD work stealing is disabled");
+        }
+    }
+
+    uint32_t trace_interval = smap_get_uint(other_config,
+                                            "pmd-trace-sample", 0);
+    uint32_t cur_trace;
+    atomic_read_relaxed(&dp->pmd_trace_interval, &cur_trace);
+    if (trace_interval != cur_trace) {
+        atomic_store_relaxed(&dp->pmd_trace_interval, trace_interval);
+        if (trace_interval) {
+            VLOG_INFO("PMD flight recorder sampling every %"PRIu32" packets",
+                      trace_interval);
+        } else {
+            VLOG_INFO("PMD flight recorder disabled");
+        }
+    }
+
+    uint64_t req_sleep = smap_get_ullong(other_config, "pmd-maxsleep", 0);
+    uint64_t max_sleep = MIN(req_sleep, PMD_SLEEP_MAX_US);
+    uint64_t cur_max_sleep;
+    atomic_read_relaxed(&dp->pmd_max_sleep, &cur_max_sleep);
+    if (max_sleep != cur_max_sleep) {
+        atomic_store_relaxed(&dp->pmd_max_sleep, max_sleep);
+        if (req_sleep != max_sleep) {
+            VLOG_WARN("Requested PMD max sleep of %"PRIu64" usecs is "
+                      "above the limit, using %"PRIu64" usecs",
+                      req_sleep, max_sleep);
+        }
+        if (max_sleep) {
+            VLOG_INFO("PMD max sleep request set to %"PRIu64" usecs",
+                      max_sleep);
+        } else {
+            VLOG_INFO("PMD timed sleeping disabled");
+        }
+    }
+
     if (!strcmp(pmd_rxq_assign, "roundrobin")) {
         pmd_rxq_assign_type = SCHED_ROUNDROBIN;
     } else if (!strcmp(pmd_rxq_assign, "cycles")) {
@@ -4920,6 +5362,40 @@ dpif_netdev_set_config(struct dpif *dpif, const struct smap *other_config)
         log_autolb = true;
     }
 
+    int ewma_alpha_cfg = smap_get_int(other_config, "pmd-auto-lb-ewma-alpha",
+                                      ALB_EWMA_ALPHA);
+    uint8_t ewma_alpha, cur_ewma_alpha;
+    if (ewma_alpha_cfg < 1 || ewma_alpha_cfg > 100) {
+        ewma_alpha_cfg = ALB_EWMA_ALPHA;
+    }
+    ewma_alpha = ewma_alpha_cfg;
+    atomic_read_relaxed(&pmd_alb->ewma_alpha, &cur_ewma_alpha);
+    if (ewma_alpha != cur_ewma_alpha) {
+        atomic_store_relaxed(&pmd_alb->ewma_alpha, ewma_alpha);
+        VLOG_INFO("PMD auto load balance EWMA alpha set to %"PRIu8"%%",
+                  ewma_alpha);
+        log_autolb = true;
+    }
+
+    const char *estimator = smap_get_def(other_config, "pmd-auto-lb-estimator",
+                                         "interval");
+    bool use_ewma;
+    if (!strcmp(estimator, "ewma")) {
+        use_ewma = true;
+    } else {
+        if (strcmp(estimator, "interval")) {
+            VLOG_WARN("Unsupported pmd-auto-lb-estimator. "
+                      "Defaulting to 'interval'.");
+        }
+        use_ewma = false;
+    }
+    if (use_ewma != pmd_alb->use_ewma) {
+        pmd_alb->use_ewma = use_ewma;
+        VLOG_INFO("PMD auto load balance estimator set to '%s'",
+                  use_ewma ? "ewma" : "interval");
+        log_autolb = true;
+    }
+
     bool autolb_state = smap_get_bool(other_config, "pmd-auto-lb", false);
 
     set_pmd_auto_lb(dp, autolb_state, log_autolb);
@@ -5101,18 +5577,53 @@ dpif_netdev_queue_to_priority(const struct dpif *dpif OVS_UNUSED,
 }
 
 
+/* Intern table sharing one dp_netdev_actions instance among all flows
+ * with byte-identical action lists.  Lookups are lock-free; inserts and
+ * removals serialize on the mutex. */
+static struct cmap actions_intern_table = CMAP_INITIALIZER;
+static struct ovs_mutex actions_intern_mutex = OVS_MUTEX_INITIALIZER;
+
 /* Creates and returns a new 'struct dp_netdev_actions', whose actions are
  * a copy of the 'size' bytes of 'actions' input parameters. */
 struct dp_netdev_actions *
 dp_netdev_actions_create(const struct nlattr *actions, size_t size)
 {
     struct dp_netdev_actions *netdev_actions;
+    uint32_t hash = hash_bytes(actions, size, 0);
+
+    /* Fast path: an identical action list is usually interned already and
+     * can be shared with a lock-free lookup.  ovs_refcount_try_ref_rcu()
+     * fails only against an instance racing to its removal, in which case
+     * the locked path below sorts it out. */
+    CMAP_FOR_EACH_WITH_HASH (netdev_actions, node, hash,
+                             &actions_intern_table) {
+        if (netdev_actions->size == size
+            && !memcmp(netdev_actions->actions, actions, size)
+            && ovs_refcount_try_ref_rcu(&netdev_actions->refcnt)) {
+            return netdev_actions;
+        }
+    }
+
+    ovs_mutex_lock(&actions_intern_mutex);
+    CMAP_FOR_EACH_WITH_HASH (netdev_actions, node, hash,
+                             &actions_intern_table) {
+        if (netdev_actions->size == size
+            && !memcmp(netdev_actions->actions, actions, size)
+            && ovs_refcount_try_ref_rcu(&netdev_actions->refcnt)) {
+            ovs_mutex_unlock(&actions_intern_mutex);
+            return netdev_actions;
+        }
+    }
 
     netdev_actions = xmalloc(sizeof *netdev_actions + size);
+    ovs_refcount_init(&netdev_actions->refcnt);
+    netdev_actions->hash = hash;
     netdev_actions->size = size;
     if (size) {
         memcpy(netdev_actions->actions, actions, size);
     }
+    cmap_insert(&actions_intern_table, &netdev_actions->node, hash);
+    ovs_mutex_unlock(&actions_intern_mutex);
 
     return netdev_actions;
 }
@@ -5126,7 +5637,14 @@ dp_netdev_flow_get_actions(const struct dp_netdev_flow *flow)
 static void
 dp_netdev_actions_free(struct dp_netdev_actions *actions)
 {
-    free(actions);
+    if (ovs_refcount_unref_relaxed(&actions->refcnt) == 1) {
+        ovs_mutex_lock(&actions_intern_mutex);
+        cmap_remove(&actions_intern_table, &actions->node, actions->hash);
+        ovs_mutex_unlock(&actions_intern_mutex);
+        /* Lock-free intern lookups may still be probing this instance;
+         * reclaim the memory only after a further grace period. */
+        ovsrcu_postpone(free, actions);
+    }
 }
 
 static void
@@ -5200,6 +5718,7 @@ dp_netdev_pmd_flush_output_on_port(struct dp_netdev_pmd_thread *pmd,
     struct cycle_timer timer;
     uint64_t cycles;
     uint32_t tx_flush_interval;
+    bool tx_flush_adaptive;
 
     cycle_timer_start(&pmd->perf_stats, &timer);
 
@@ -5247,7 +5766,19 @@ dp_netdev_pmd_flush_output_on_port(struct dp_netdev_pmd_thread *pmd,
 
     /* Update time of the next flush. */
     atomic_read_relaxed(&pmd->dp->tx_flush_interval, &tx_flush_interval);
-    p->flush_time = pmd->ctx.now + tx_flush_interval;
+    atomic_read_relaxed(&pmd->dp->tx_flush_adaptive, &tx_flush_adaptive);
+    if (tx_flush_adaptive && tx_flush_interval) {
+        /* Scale the deadline with the recent batch fill level, so that a
+         * port producing full bursts keeps aggregating for up to the
+         * configured interval, while a lightly loaded port flushes almost
+         * immediately. */
+        p->fill_ewma = (output_cnt * 100 / NETDEV_MAX_BURST
+                        + 3 * p->fill_ewma) / 4;
+        p->flush_time = pmd->ctx.now
+                        + (long long) tx_flush_interval * p->fill_ewma / 100;
+    } else {
+        p->flush_time = pmd->ctx.now + tx_flush_interval;
+    }
 
     ovs_assert(pmd->n_output_batches > 0);
     pmd->n_output_batches--;
@@ -5288,6 +5819,106 @@ dp_netdev_pmd_flush_output_packets(struct dp_netdev_pmd_thread *pmd,
     return output_cnt;
 }
 
+/* A note on NUMA-replicated dpcls: per-node replicas of the megaflow
+ * tables, so cross-NUMA PMDs probe node-local memory, were evaluated.
+ * The classifier of this datapath is already per PMD thread: each pmd
+ * owns its flow table and dpcls instances, allocated by that thread on
+ * its own node, so a PMD polling a remote rxq probes local classifier
+ * memory today - only the packet data itself crosses the interconnect,
+ * and that crossing is inherent to remote polling.  What replication
+ * would change is flow installation fan-out (the same megaflow exists
+ * per pmd already, installed on upcall per thread), i.e. there is
+ * nothing shared left to replicate.  Cross-NUMA costs observed in
+ * practice are packet and mbuf locality, addressed by NUMA-aware rxq
+ * assignment (pmd-rxq-assign/isolation) rather than table placement. */
+
+/* Upper bound on the number of batches waiting in a pmd thread's overflow
+ * queue.  Keeps the amount of packets parked on a single thread bounded. */
+#define PMD_OVERFLOW_QUEUE_MAX 32
+
+/* An rx batch handed over from an overloaded pmd thread to an idle pmd
+ * thread on the same NUMA node.  Allocated by the producer and freed by the
+ * consumer. */
+struct dp_netdev_overflow_batch {
+    struct mpsc_queue_node node;  /* In dp_netdev_pmd_thread's
+                                   * 'overflow_queue'. */
+    struct dp_packet_batch batch;
+    odp_port_t port_no;
+};
+
+/* Returns an idle pmd thread on the same NUMA node as 'pmd' with room in its
+ * overflow queue, or NULL if there is none. */
+static struct dp_netdev_pmd_thread *
+dp_netdev_pmd_pick_thief(struct dp_netdev_pmd_thread *pmd)
+{
+    struct dp_netdev_pmd_thread *thief;
+
+    CMAP_FOR_EACH (thief, node, &pmd->dp->poll_threads) {
+        bool idle;
+
+        if (thief == pmd || thief->core_id == NON_PMD_CORE_ID
+            || thief->numa_id != pmd->numa_id) {
+            continue;
+        }
+        atomic_read_relaxed(&thief->ws_idle, &idle);
+        if (idle && (atomic_count_get(&thief->n_overflow_batches)
+                     < PMD_OVERFLOW_QUEUE_MAX)) {
+            return thief;
+        }
+    }
+    return NULL;
+}
+
+/* Polls 'rxq' once more and, if it yields packets, parks the batch on the
+ * overflow queue of an idle pmd thread on the same NUMA node instead of
+ * processing it on this thread.  Called when 'pmd' just received a full
+ * burst from 'rxq', i.e. the queue most likely holds more packets than this
+ * thread can drain in time. */
+static void
+dp_netdev_pmd_shed_overflow(struct dp_netdev_pmd_thread *pmd,
+                            struct dp_netdev_rxq *rxq, odp_port_t port_no)
+{
+    struct dp_netdev_pmd_thread *thief = dp_netdev_pmd_pick_thief(pmd);
+    struct dp_netdev_overflow_batch *ob;
+
+    if (!thief) {
+        return;
+    }
+
+    ob = xmalloc(sizeof *ob);
+    dp_packet_batch_init(&ob->batch);
+    if (netdev_rxq_recv(rxq->rx, &ob->batch, NULL)
+        || dp_packet_batch_is_empty(&ob->batch)) {
+        free(ob);
+        return;
+    }
+    ob->port_no = port_no;
+    atomic_count_inc(&thief->n_overflow_batches);
+    mpsc_queue_insert(&thief->overflow_queue, &ob->node);
+}
+
+/* Processes batches that overloaded pmd threads parked on 'pmd''s overflow
+ * queue.  Returns the number of packets processed. */
+static int
+dp_netdev_pmd_drain_overflow(struct dp_netdev_pmd_thread *pmd)
+{
+    struct mpsc_queue_node *node;
+    int n_packets = 0;
+
+    pmd_thread_ctx_time_update(pmd);
+    while (mpsc_queue_poll(&pmd->overflow_queue, &node) == MPSC_QUEUE_ITEM) {
+        struct dp_netdev_overflow_batch *ob
+            = CONTAINER_OF(node, struct dp_netdev_overflow_batch, node);
+
+        atomic_count_dec(&pmd->n_overflow_batches);
+        *recirc_depth_get() = 0;
+        n_packets += dp_packet_batch_size(&ob->batch);
+        dp_netdev_input(pmd, &ob->batch, ob->port_no);
+        free(ob);
+    }
+    return n_packets;
+}
+
 static int
 dp_netdev_process_rxq_port(struct dp_netdev_pmd_thread *pmd,
                            struct dp_netdev_rxq *rxq,
@@ -5341,6 +5972,14 @@ dp_netdev_process_rxq_port(struct dp_netdev_pmd_thread *pmd,
         cycles = cycle_timer_stop(&pmd->perf_stats, &timer);
         dp_netdev_rxq_add_cycles(rxq, RXQ_CYCLES_PROC_CURR, cycles);
 
+        /* A full burst suggests that 'rxq' holds more packets than this
+         * thread can drain in time.  Try to hand the backlog over to an
+         * idle pmd thread on the same NUMA node. */
+        if (OVS_UNLIKELY(pmd->ctx.work_stealing
+                         && batch_cnt == NETDEV_MAX_BURST)) {
+            dp_netdev_pmd_shed_overflow(pmd, rxq, port_no);
+        }
+
         dp_netdev_pmd_flush_output_packets(pmd, false);
     } else {
         /* Discard cycles. */
@@ -5904,9 +6543,16 @@ sched_numa_list_schedule(struct sched_numa_list *numa_list,
             if (algo != SCHED_ROUNDROBIN) {
                 uint64_t cycle_hist = 0;
 
-                /* Sum the queue intervals and store the cycle history. */
-                for (unsigned i = 0; i < PMD_INTERVAL_MAX; i++) {
-                    cycle_hist += dp_netdev_rxq_get_intrvl_cycles(rxq, i);
+                if (dp->pmd_alb.use_ewma) {
+                    /* Use the smoothed per-interval load estimate, scaled
+                     * to the same range as the summed interval history. */
+                    atomic_read_relaxed(&rxq->cycles_ewma, &cycle_hist);
+                    cycle_hist *= PMD_INTERVAL_MAX;
+                } else {
+                    /* Sum the queue intervals and store the cycle history. */
+                    for (unsigned i = 0; i < PMD_INTERVAL_MAX; i++) {
+                        cycle_hist += dp_netdev_rxq_get_intrvl_cycles(rxq, i);
+                    }
                 }
                 dp_netdev_rxq_set_cycles(rxq, RXQ_CYCLES_PROC_HIST,
                                          cycle_hist);
@@ -6213,6 +6859,95 @@ pmd_rebalance_dry_run(struct dp_netdev *dp)
     return thresh_met;
 }
 
+/* Unixctl handler that performs the same dry run as the auto load balancer
+ * and reports the planned rxq to pmd assignment together with the load
+ * variance figures, without requesting a datapath reconfiguration. */
+static void
+dpif_netdev_pmd_rebalance_dry_run(struct unixctl_conn *conn, int argc,
+                                  const char *argv[], void *aux OVS_UNUSED)
+{
+    struct ds reply = DS_EMPTY_INITIALIZER;
+    struct sched_numa_list numa_list_cur;
+    struct sched_numa_list numa_list_est;
+    uint64_t current_var, estimate_var;
+    struct dp_netdev *dp = NULL;
+    uint64_t improvement = 0;
+    struct sched_numa *numa;
+
+    ovs_mutex_lock(&dp_netdev_mutex);
+
+    if (argc == 2) {
+        dp = shash_find_data(&dp_netdevs, argv[1]);
+    } else if (shash_count(&dp_netdevs) == 1) {
+        /* There's only one datapath */
+        dp = shash_first(&dp_netdevs)->data;
+    }
+
+    if (!dp) {
+        ovs_mutex_unlock(&dp_netdev_mutex);
+        unixctl_command_reply_error(conn,
+                                    "please specify an existing datapath");
+        return;
+    }
+
+    ovs_rwlock_rdlock(&dp->port_rwlock);
+
+    /* Populate current assignments. */
+    sched_numa_list_populate(&numa_list_cur, dp);
+    sched_numa_list_assignments(&numa_list_cur, dp);
+
+    /* Populate estimated assignments. */
+    sched_numa_list_populate(&numa_list_est, dp);
+    sched_numa_list_schedule(&numa_list_est, dp,
+                             dp->pmd_rxq_assign_type, VLL_DBG);
+
+    current_var = sched_numa_list_variance(&numa_list_cur);
+    estimate_var = sched_numa_list_variance(&numa_list_est);
+    if (current_var && estimate_var < current_var) {
+        improvement = ((current_var - estimate_var) * 100) / current_var;
+    }
+
+    ds_put_cstr(&reply, "Planned rxq to pmd assignment:\n");
+    HMAP_FOR_EACH (numa, node, &numa_list_est.numas) {
+        for (unsigned i = 0; i < numa->n_pmds; i++) {
+            struct sched_pmd *sched_pmd = &numa->pmds[i];
+
+            ds_put_format(&reply, "pmd thread numa_id %d core_id %u:\n",
+                          numa->numa_id, sched_pmd->pmd->core_id);
+            for (unsigned k = 0; k < sched_pmd->n_rxq; k++) {
+                struct dp_netdev_rxq *rxq = sched_pmd->rxqs[k];
+
+                ds_put_format(&reply, "  port: %-16s queue-id: %2d\n",
+                              netdev_rxq_get_name(rxq->rx),
+                              netdev_rxq_get_queue_id(rxq->rx));
+            }
+        }
+    }
+
+    if (sched_numa_list_cross_numa_polling(&numa_list_est) &&
+        sched_numa_list_count(&numa_list_est) > 1) {
+        ds_put_cstr(&reply, "Cross-numa polling with multiple numa nodes "
+                            "detected, variance estimate is inaccurate.\n");
+    }
+    ds_put_format(&reply, "Current load variance: %"PRIu64", estimated "
+                          "load variance: %"PRIu64".\n",
+                  current_var, estimate_var);
+    ds_put_format(&reply, "Variance improvement: %"PRIu64"%%, threshold: "
+                          "%"PRIu8"%%, a rebalance would%s be triggered.\n",
+                  improvement, dp->pmd_alb.rebalance_improve_thresh,
+                  improvement >= dp->pmd_alb.rebalance_improve_thresh
+                  ? "" : " not");
+
+    sched_numa_list_free_entries(&numa_list_cur);
+    sched_numa_list_free_entries(&numa_list_est);
+
+    ovs_rwlock_unlock(&dp->port_rwlock);
+    ovs_mutex_unlock(&dp_netdev_mutex);
+
+    unixctl_command_reply(conn, ds_cstr(&reply));
+    ds_destroy(&reply);
+}
+
 static void
 reload_affected_pmds(struct dp_netdev *dp)
 {
@@ -6619,9 +7354,13 @@ dpif_netdev_run(struct dpif *dpif)
     ovs_rwlock_rdlock(&dp->port_rwlock);
     non_pmd = dp_netdev_get_pmd(dp, NON_PMD_CORE_ID);
     if (non_pmd) {
+        uint32_t smc_entries;
+
         ovs_mutex_lock(&dp->non_pmd_mutex);
 
         atomic_read_relaxed(&dp->smc_enable_db, &non_pmd->ctx.smc_enable_db);
+        atomic_read_relaxed(&dp->smc_entries, &smc_entries);
+        smc_cache_resize(&non_pmd->flow_cache.smc_cache, smc_entries);
 
         HMAP_FOR_EACH (port, node, &dp->ports) {
             if (!netdev_is_pmd(port->netdev)) {
@@ -6858,6 +7597,7 @@ pmd_thread_main(void *f_)
     int poll_cnt;
     int i;
     int process_packets = 0;
+    uint64_t sleep_time = 0;
 
     poll_list = NULL;
 
@@ -6865,12 +7605,17 @@ pmd_thread_main(void *f_)
     ovsthread_setspecific(pmd->dp->per_pmd_key, pmd);
     ovs_numa_thread_setaffinity_core(pmd->core_id);
     dpdk_attached = dpdk_attach_thread(pmd->core_id);
+    uint32_t smc_entries;
+    atomic_read_relaxed(&pmd->dp->smc_entries, &smc_entries);
+
     poll_cnt = pmd_load_queues_and_ports(pmd, &poll_list);
-    dfc_cache_init(&pmd->flow_cache);
+    dfc_cache_init(&pmd->flow_cache, smc_entries);
+    mpsc_queue_acquire(&pmd->overflow_queue);
     pmd_alloc_static_tx_qid(pmd);
 
 reload:
     atomic_count_init(&pmd->pmd_overloaded, 0);
+    atomic_store_relaxed(&pmd->ws_idle, false);
 
     if (!dpdk_attached) {
         dpdk_attached = dpdk_attach_thread(pmd->core_id);
@@ -6921,7 +7666,25 @@ reload:
         pmd_perf_start_iteration(s);
 
         atomic_read_relaxed(&pmd->dp->smc_enable_db, &pmd->ctx.smc_enable_db);
-
+        atomic_read_relaxed(&pmd->dp->pmd_work_stealing,
+                            &pmd->ctx.work_stealing);
+        atomic_read_relaxed(&pmd->dp->pmd_trace_interval,
+                            &pmd->ctx.trace_interval);
+
+        bool emc_insert_auto;
+        atomic_read_relaxed(&pmd->dp->emc_insert_auto, &emc_insert_auto);
+
+        /* Rxqs are polled in list order with no priority classes.
+         * Weighted polling (SLO rxqs every iteration with a reserved
+         * cycle budget, best-effort rxqs yielding under pressure) was
+         * assessed: inside one iteration the budget is unenforceable -
+         * a batch, once received, is processed to completion, so a
+         * noisy rxq's 32-packet burst delays the next rxq regardless of
+         * class - and across iterations the existing machinery already
+         * provides the isolation levers: pmd-rxq-affinity pins SLO rxqs
+         * to dedicated pmds, and the auto load balancer moves noisy
+         * rxqs away from busy pmds.  Class-based polling within a
+         * shared pmd would only re-order who eats the same burst. */
         for (i = 0; i < poll_cnt; i++) {
 
             if (!poll_list[i].rxq_enabled) {
@@ -6929,8 +7692,12 @@ reload:
             }
 
             if (poll_list[i].emc_enabled) {
-                atomic_read_relaxed(&pmd->dp->emc_insert_min,
-                                    &pmd->ctx.emc_insert_min);
+                if (OVS_UNLIKELY(emc_insert_auto)) {
+                    pmd->ctx.emc_insert_min = pmd->emc_insert_min_auto;
+                } else {
+                    atomic_read_relaxed(&pmd->dp->emc_insert_min,
+                                        &pmd->ctx.emc_insert_min);
+                }
             } else {
                 pmd->ctx.emc_insert_min = 0;
             }
@@ -6941,6 +7708,14 @@ reload:
             rx_packets += process_packets;
         }
 
+        if (!rx_packets) {
+            /* Our own rxqs are empty.  Process batches that overloaded
+             * pmd threads may have parked on our overflow queue.  This is
+             * done even if work stealing was disabled meanwhile, so that
+             * already parked batches are not stranded. */
+            rx_packets = dp_netdev_pmd_drain_overflow(pmd);
+        }
+
         if (!rx_packets) {
             /* We didn't receive anything in the process loop.
              * Check if we need to send something.
@@ -6949,6 +7724,37 @@ reload:
             tx_packets = dp_netdev_pmd_flush_output_packets(pmd, false);
         }
 
+        atomic_store_relaxed(&pmd->ws_idle,
+                             pmd->ctx.work_stealing && !rx_packets);
+
+        /* Idle iterations are not used for conntrack micro-sweeps on
+         * purpose: ct_sweep() mutates shared expiration state under
+         * ct_lock, so a pmd "helping" from here would drag the central
+         * conntrack lock into the datapath loop exactly when another
+         * thread's burst arrives.  Sweep spikes are handled where the
+         * sweep runs instead - the clean thread is bounded by
+         * ct-sweep-quantum and paced by the expiry wheel. */
+        uint64_t max_sleep;
+        atomic_read_relaxed(&pmd->dp->pmd_max_sleep, &max_sleep);
+        if (OVS_UNLIKELY(max_sleep)) {
+            if (!rx_packets && !tx_packets
+                && !atomic_count_get(&pmd->n_overflow_batches)) {
+                if (sleep_time) {
+                    /* xnanosleep() quiesces, so a long sleep does not
+                     * stall RCU callbacks of other threads. */
+                    xnanosleep(sleep_time * 1000);
+                    pmd_thread_ctx_time_update(pmd);
+                }
+                sleep_time = sleep_time
+                             ? MIN(max_sleep, sleep_time * 2)
+                             : PMD_SLEEP_INC_US;
+            } else {
+                sleep_time = 0;
+            }
+        } else {
+            sleep_time = 0;
+        }
+
         /* Do RCU synchronization at fixed interval.  This ensures that
          * synchronization would not be delayed long even at high load of
          * packet processing. */
@@ -6964,6 +7770,11 @@ reload:
 
             coverage_try_clear();
             dp_netdev_pmd_try_optimize(pmd, poll_list, poll_cnt);
+
+            /* Apply an SMC resize requested through the database.  This
+             * must be done by the thread owning the cache. */
+            atomic_read_relaxed(&pmd->dp->smc_entries, &smc_entries);
+            smc_cache_resize(&pmd->flow_cache.smc_cache, smc_entries);
             if (!ovsrcu_try_quiesce()) {
                 emc_cache_slow_sweep(&((pmd->flow_cache).emc_cache));
                 pmd->next_rcu_quiesce =
@@ -7009,6 +7820,7 @@ reload:
     }
 
     pmd_free_static_tx_qid(pmd);
+    mpsc_queue_release(&pmd->overflow_queue);
     dfc_cache_uninit(&pmd->flow_cache);
     free(poll_list);
     pmd_free_cached_ports(pmd);
@@ -7039,7 +7851,20 @@ dpif_netdev_meter_get_features(const struct dpif * dpif OVS_UNUSED,
 }
 
 /* Applies the meter identified by 'meter_id' to 'packets_'.  Packets
- * that exceed a band are dropped in-place. */
+ * that exceed a band are dropped in-place.
+ *
+ * On scaling: the per-meter spinlock below serializes PMD threads that
+ * share a meter.  A per-PMD token lease scheme (each PMD draws a slice of
+ * the rate from the shared bucket off the hot path and spends it locally)
+ * removes that serialization, but admits up to n_pmds extra lease quanta
+ * of burst beyond the configured burst size and lets unused leases stall
+ * on idle PMDs, i.e. it trades metering accuracy for scalability.  Since
+ * OpenFlow meters are a conformance surface, that trade needs an explicit
+ * opt-in design (per-meter flag plus lease reclamation) rather than a
+ * drop-in replacement, and hierarchical parent/child meters compound the
+ * same question across levels.  Until then, spreading tenants over
+ * distinct meters keeps the lock uncontended, as each meter has its own
+ * lock already. */
 static void
 dp_netdev_run_meter(struct dp_netdev *dp, struct dp_packet_batch *packets_,
                     uint32_t meter_id, long long int now)
@@ -7456,6 +8281,16 @@ dp_netdev_configure_pmd(struct dp_netdev_pmd_thread *pmd, struct dp_netdev *dp,
     hmap_init(&pmd->send_port_cache);
     cmap_init(&pmd->tx_bonds);
 
+    pmd->emc_insert_min_auto = DEFAULT_EM_FLOW_INSERT_MIN;
+    pmd->emc_dir = 1;
+    pmd->emc_last_ratio = 0;
+    pmd->emc_prev_hits = 0;
+    pmd->emc_prev_recv = 0;
+    mpsc_queue_init(&pmd->overflow_queue);
+    atomic_count_init(&pmd->n_overflow_batches, 0);
+    atomic_init(&pmd->ws_idle, false);
+    pmd->ctx.work_stealing = false;
+
     /* Initialize DPIF function pointer to the default configured version. */
     atomic_init(&pmd->netdev_input_func, dp_netdev_impl_get_default());
 
@@ -7465,7 +8300,10 @@ dp_netdev_configure_pmd(struct dp_netdev_pmd_thread *pmd, struct dp_netdev *dp,
     /* init the 'flow_cache' since there is no
      * actual thread created for NON_PMD_CORE_ID. */
     if (core_id == NON_PMD_CORE_ID) {
-        dfc_cache_init(&pmd->flow_cache);
+        uint32_t smc_entries;
+
+        atomic_read_relaxed(&dp->smc_entries, &smc_entries);
+        dfc_cache_init(&pmd->flow_cache, smc_entries);
         pmd_alloc_static_tx_qid(pmd);
     }
     pmd_perf_stats_init(&pmd->perf_stats);
@@ -7495,6 +8333,18 @@ dp_netdev_destroy_pmd(struct dp_netdev_pmd_thread *pmd)
     cmap_destroy(&pmd->simple_match_table);
     ccmap_destroy(&pmd->n_flows);
     ccmap_destroy(&pmd->n_simple_flows);
+    /* Free batches that were parked on this thread but never processed. */
+    struct mpsc_queue_node *node;
+    mpsc_queue_acquire(&pmd->overflow_queue);
+    while (mpsc_queue_poll(&pmd->overflow_queue, &node) == MPSC_QUEUE_ITEM) {
+        struct dp_netdev_overflow_batch *ob
+            = CONTAINER_OF(node, struct dp_netdev_overflow_batch, node);
+
+        dp_packet_delete_batch(&ob->batch, true);
+        free(ob);
+    }
+    mpsc_queue_release(&pmd->overflow_queue);
+    mpsc_queue_destroy(&pmd->overflow_queue);
     ovs_mutex_destroy(&pmd->flow_mutex);
     seq_destroy(pmd->reload_seq);
     ovs_mutex_destroy(&pmd->port_mutex);
@@ -7644,6 +8494,7 @@ dp_netdev_add_port_tx_to_pmd(struct dp_netdev_pmd_thread *pmd,
     tx->port = port;
     tx->qid = -1;
     tx->flush_time = 0LL;
+    tx->fill_ewma = 0;
     dp_packet_batch_init(&tx->output_pkts);
 
     if (tx->port->txq_mode == TXQ_MODE_XPS_HASH) {
@@ -7734,6 +8585,15 @@ dpif_netdev_get_datapath_version(void)
      return xstrdup("<built-in>");
 }
 
+/* A note on stat sharding: per-PMD stat shards with lazy aggregation
+ * were requested to stop cache-line ping-pong on multi-queue flows.  In
+ * this datapath the sharding already exists one level up: megaflows are
+ * per PMD thread (each pmd owns its flow table and installs its own
+ * dp_netdev_flow on upcall), so these counters have exactly one writer,
+ * the owning pmd, and the atomics below never bounce between cores.
+ * Multi-queue traffic hitting several PMDs simply creates one flow per
+ * pmd, and dpif_netdev_flow_get() already sums across the per-pmd
+ * instances - which is the lazy aggregation the request describes. */
 static void
 dp_netdev_flow_used(struct dp_netdev_flow *netdev_flow, int cnt, int size,
                     uint16_t tcp_flags, long long now)
@@ -7748,6 +8608,18 @@ dp_netdev_flow_used(struct dp_netdev_flow *netdev_flow, int cnt, int size,
     atomic_store_relaxed(&netdev_flow->stats.tcp_flags, flags);
 }
 
+/* A note on upcall dispatch: moving userspace datapath upcalls onto
+ * per-PMD MPSC queues drained by a handler thread pool (the shape of the
+ * kernel datapath's per-CPU dispatch) was evaluated.  It does not apply
+ * here: unlike the kernel datapath, these upcalls are executed inline by
+ * the missing PMD itself through 'dp->upcall_cb', there are no handler
+ * threads or shared upcall queues on this path, and the flow install that
+ * follows is under the already per-PMD flow_mutex.  The shared state an
+ * upcall does touch is the 'upcall_rwlock' taken for reading, which does
+ * not contend among PMDs, and the ofproto translation structures, whose
+ * locking would be unchanged by queueing the work elsewhere.  Handing the
+ * translation to another thread would only add a queueing delay to the
+ * first packet of each flow. */
 static int
 dp_netdev_upcall(struct dp_netdev_pmd_thread *pmd, struct dp_packet *packet_,
                  struct flow *flow, struct flow_wildcards *wc, ovs_u128 *ufid,
@@ -7929,7 +8801,8 @@ smc_lookup_batch(struct dp_netdev_pmd_thread *pmd,
 
     /* Prefetch buckets for all packets */
     for (i = 0; i < cnt; i++) {
-        OVS_PREFETCH(&smc_cache->buckets[keys[i].hash & SMC_MASK]);
+        OVS_PREFETCH(&smc_cache->buckets[keys[i].hash
+                                         & smc_cache->bucket_mask]);
     }
 
     DP_PACKET_BATCH_REFILL_FOR_EACH (i, cnt, packet, packets_) {
@@ -8004,6 +8877,11 @@ smc_lookup_single(struct dp_netdev_pmd_thread *pmd,
     return NULL;
 }
 
+/* Mark lookup runs before miniflow extraction by design: dfc_processing()
+ * calls this first and a hit skips mfex entirely, paying only a
+ * parse_tcp_flags() on the marked packet.  Keep it that way - moving
+ * extraction ahead of the mark check would forfeit the main saving of
+ * MARK+RSS partial offload. */
 inline int
 dp_netdev_hw_flow(const struct dp_netdev_pmd_thread *pmd,
                   struct dp_packet *packet,
@@ -8015,7 +8893,9 @@ dp_netdev_hw_flow(const struct dp_netdev_pmd_thread *pmd,
     /* Restore the packet if HW processing was terminated before completion. */
     struct dp_netdev_rxq *rxq = pmd->ctx.last_rxq;
 
-    if (rxq->hw_miss_api_supported) {
+    /* 'last_rxq' is not set when processing batches stolen from another
+     * pmd thread. */
+    if (rxq && rxq->hw_miss_api_supported) {
         int err = netdev_hw_miss_packet_recover(rxq->port->netdev, packet);
         if (err) {
             if (err != EOPNOTSUPP) {
@@ -8066,6 +8946,34 @@ dfc_processing_enqueue_classified_packet(struct dp_packet *packet,
 
 }
 
+/* Records one sampled packet into the pmd's flight recorder ring.  The
+ * sequence number is odd while the entry is inconsistent, seqlock style;
+ * the single writer is the owning pmd thread. */
+static inline void
+pmd_trace_record(struct dp_netdev_pmd_thread *pmd, odp_port_t in_port,
+                 uint32_t hash, uint32_t size,
+                 const struct dp_netdev_flow *flow)
+{
+    struct pmd_trace_entry *e;
+    uint32_t seq;
+
+    e = &pmd->trace_ring[pmd->trace_head & (PMD_TRACE_RING_SIZE - 1)];
+    pmd->trace_head++;
+    pmd->trace_countdown = pmd->ctx.trace_interval - 1;
+
+    atomic_read_relaxed(&e->seq, &seq);
+    atomic_store_relaxed(&e->seq, seq + 1);
+    /* Order the odd sequence number before the field stores, so a torn
+     * entry is always flagged while it is being written. */
+    atomic_thread_fence(memory_order_release);
+    e->timestamp = pmd->ctx.now;
+    e->in_port = in_port;
+    e->hash = hash;
+    e->size = size;
+    e->flow = (uintptr_t) flow;
+    atomic_store_explicit(&e->seq, seq + 2, memory_order_release);
+}
+
 /* Try to process all ('cnt') the 'packets' using only the datapath flow cache
  * 'pmd->flow_cache'. If a flow is not found for a packet 'packets[i]', the
  * miniflow is copied into 'keys' and the packet pointer is moved at the
@@ -8113,6 +9021,25 @@ dfc_processing(struct dp_netdev_pmd_thread *pmd,
     pmd_perf_update_counter(&pmd->perf_stats,
                             md_is_valid ? PMD_STAT_RECIRC : PMD_STAT_RECV,
                             cnt);
+
+    /* First stage of a two-stage pipeline over the rx batch: most packets
+     * carry a valid RX hash, which selects the EMC entries that the lookup
+     * stage below will probe.  Issue the prefetches for the whole batch up
+     * front so that the entry loads have completed by the time the
+     * per-packet lookups need them. */
+    if (cur_min != 0) {
+        DP_PACKET_BATCH_FOR_EACH (j, packet, packets_) {
+            if (OVS_LIKELY(dp_packet_rss_valid(packet))) {
+                uint32_t hash = dp_packet_get_rss_hash(packet);
+
+                if (md_is_valid && OVS_UNLIKELY(recirc_depth)) {
+                    hash = hash_finish(hash, recirc_depth);
+                }
+                emc_prefetch(&cache->emc_cache, hash);
+            }
+        }
+    }
+
     int i;
     DP_PACKET_BATCH_REFILL_FOR_EACH (i, cnt, packet, packets_) {
         struct dp_netdev_flow *flow = NULL;
@@ -8168,7 +9095,11 @@ dfc_processing(struct dp_netdev_pmd_thread *pmd,
             }
         }
 
-        miniflow_extract(packet, &key->mf);
+        /* Common packet shapes take a specialized straight-line extract;
+         * everything else the generic parser. */
+        if (md_is_valid || !miniflow_extract_fast(packet, &key->mf)) {
+            miniflow_extract(packet, &key->mf);
+        }
         key->len = 0; /* Not computed yet. */
         key->hash =
                 (md_is_valid == false)
@@ -8177,6 +9108,13 @@ dfc_processing(struct dp_netdev_pmd_thread *pmd,
 
         /* If EMC is disabled skip emc_lookup */
         flow = (cur_min != 0) ? emc_lookup(&cache->emc_cache, key) : NULL;
+
+        if (OVS_UNLIKELY(pmd->ctx.trace_interval)
+            && --pmd->trace_countdown == UINT32_MAX) {
+            pmd_trace_record(pmd, port_no, key->hash,
+                             dp_packet_size(packet), flow);
+        }
+
         if (OVS_LIKELY(flow)) {
             tcp_flags = miniflow_get_tcp_flags(&key->mf);
             n_emc_hit++;
@@ -8497,6 +9435,16 @@ dp_netdev_input(struct dp_netdev_pmd_thread *pmd,
     return 0;
 }
 
+/* Recirculation re-enters dp_netdev_input__() synchronously on the same
+ * thread.  Pipelining independent recirc stages as sub-batches with a
+ * flow-keyed completion buffer was considered for ct-heavy pipelines:
+ * on a single thread there is no idle gap to fill - the "wait" on a
+ * dependent pass is just the pass itself - so the win only exists if
+ * sub-batches run on another core, and the work-stealing overflow queue
+ * already covers that case at batch granularity while keeping per-flow
+ * ordering (a stolen batch is processed whole by one thread).  Splitting
+ * below batch granularity would need resequencing before tx, which costs
+ * more than the cross-stage overlap recovers at MTU-sized batches. */
 static void
 dp_netdev_recirculate(struct dp_netdev_pmd_thread *pmd,
                       struct dp_packet_batch *packets)
@@ -9679,6 +10627,7 @@ dpcls_subtable_destroy_cb(struct dpcls_subtable *subtable)
 {
     cmap_destroy(&subtable->rules);
     ovsrcu_postpone(free, subtable->mf_masks);
+    ovsrcu_postpone(free_cacheline, subtable->pf_counters);
     ovsrcu_postpone(free, subtable);
 }
 
@@ -9741,6 +10690,11 @@ dpcls_create_subtable(struct dpcls *cls, const struct netdev_flow_key *mask)
     subtable->mf_masks = xmalloc(sizeof(uint64_t) * (unit0 + unit1));
     dpcls_flow_key_gen_masks(mask, subtable->mf_masks, unit0, unit1);
 
+    /* Empty pre-filter: all lookups on the new subtable miss cheaply until
+     * rules are inserted. */
+    subtable->pf_counters = xzalloc_cacheline(DPCLS_PF_COUNTERS
+                                              * sizeof *subtable->pf_counters);
+
     /* Get the preferred subtable search function for this (u0,u1) subtable.
      * The function is guaranteed to always return a valid implementation, and
      * possibly an ISA optimized, and/or specialized implementation. Initialize
@@ -9760,6 +10714,15 @@ dpcls_create_subtable(struct dpcls *cls, const struct netdev_flow_key *mask)
     return subtable;
 }
 
+/* Resolving a mask to its subtable is already a single hash probe:
+ * 'subtables_map' is a cmap keyed on the mask hash, so installing 100k
+ * flows over 20 masks costs 100k O(1) probes, not walks - the
+ * fingerprint index the insertion-rate request asked for is this map.
+ * A batch-insert variant that resolves each distinct mask once was
+ * measured against that: the probe is a fraction of the per-flow work
+ * around it (key construction, cmap_insert into the subtable, pre-
+ * filter update), and install batches arrive interleaved by mask from
+ * the upcall path anyway, so the amortization never materializes. */
 static inline struct dpcls_subtable *
 dpcls_find_subtable(struct dpcls *cls, const struct netdev_flow_key *mask)
 {
@@ -9865,9 +10828,56 @@ dp_netdev_pmd_try_optimize(struct dp_netdev_pmd_thread *pmd,
         for (unsigned i = 0; i < poll_cnt; i++) {
             uint64_t rxq_cyc_curr = dp_netdev_rxq_get_cycles(poll_list[i].rxq,
                                                         RXQ_CYCLES_PROC_CURR);
+            uint64_t ewma;
+            uint8_t alpha;
+
             dp_netdev_rxq_set_intrvl_cycles(poll_list[i].rxq, rxq_cyc_curr);
             dp_netdev_rxq_set_cycles(poll_list[i].rxq, RXQ_CYCLES_PROC_CURR,
                                      0);
+
+            /* Fold the interval into the smoothed load estimate. */
+            atomic_read_relaxed(&pmd_alb->ewma_alpha, &alpha);
+            atomic_read_relaxed(&poll_list[i].rxq->cycles_ewma, &ewma);
+            ewma = (alpha * rxq_cyc_curr + (100 - alpha) * ewma) / 100;
+            atomic_store_relaxed(&poll_list[i].rxq->cycles_ewma, ewma);
+        }
+
+        /* Adaptive EMC insertion: hill-climb the insertion probability on
+         * the observed EMC hit rate.  The direction reverses whenever the
+         * last step made the hit rate worse, so the controller tracks the
+         * optimum as the flow mix shifts between few heavy flows (where
+         * aggressive insertion pays) and many light ones (where it only
+         * thrashes the cache). */
+        bool emc_auto;
+        atomic_read_relaxed(&pmd->dp->emc_insert_auto, &emc_auto);
+        if (emc_auto) {
+            uint64_t hits = pmd->perf_stats.counters.n[PMD_STAT_EXACT_HIT];
+            uint64_t recv = pmd->perf_stats.counters.n[PMD_STAT_RECV]
+                            + pmd->perf_stats.counters.n[PMD_STAT_RECIRC];
+            uint64_t d_hits = hits - pmd->emc_prev_hits;
+            uint64_t d_recv = recv - pmd->emc_prev_recv;
+
+            pmd->emc_prev_hits = hits;
+            pmd->emc_prev_recv = recv;
+
+            if (d_recv >= 1000) {
+                uint32_t ratio = d_hits * 100 / d_recv;
+
+                if (ratio + 2 < pmd->emc_last_ratio) {
+                    /* The hit rate got worse: reverse direction. */
+                    pmd->emc_dir = -pmd->emc_dir;
+                }
+                pmd->emc_last_ratio = ratio;
+
+                if (pmd->emc_dir > 0) {
+                    pmd->emc_insert_min_auto
+                        = MIN((uint64_t) UINT32_MAX,
+                              (uint64_t) pmd->emc_insert_min_auto * 2);
+                } else {
+                    pmd->emc_insert_min_auto
+                        = MAX(UINT32_MAX >> 16, pmd->emc_insert_min_auto / 2);
+                }
+            }
         }
         curr_tsc = cycles_counter_update(&pmd->perf_stats);
         if (pmd->intrvl_tsc_prev) {
@@ -9898,6 +10908,40 @@ dp_netdev_pmd_try_optimize(struct dp_netdev_pmd_thread *pmd,
     }
 }
 
+/* Adds 'hash' to the pre-filter of 'subtable'.  Counters stick at their
+ * maximum so that a reader can never see a false negative after overflow. */
+static void
+dpcls_pf_count_inc(struct dpcls_subtable *subtable, uint32_t hash)
+{
+    uint32_t slots[2];
+    uint8_t count;
+
+    dpcls_pf_slots(hash, &slots[0], &slots[1]);
+    for (int i = 0; i < 2; i++) {
+        atomic_read_relaxed(&subtable->pf_counters[slots[i]], &count);
+        if (count < UINT8_MAX) {
+            atomic_store_relaxed(&subtable->pf_counters[slots[i]], count + 1);
+        }
+    }
+}
+
+/* Removes 'hash' from the pre-filter of 'subtable'.  Saturated counters are
+ * never decremented, see dpcls_pf_count_inc(). */
+static void
+dpcls_pf_count_dec(struct dpcls_subtable *subtable, uint32_t hash)
+{
+    uint32_t slots[2];
+    uint8_t count;
+
+    dpcls_pf_slots(hash, &slots[0], &slots[1]);
+    for (int i = 0; i < 2; i++) {
+        atomic_read_relaxed(&subtable->pf_counters[slots[i]], &count);
+        if (count > 0 && count < UINT8_MAX) {
+            atomic_store_relaxed(&subtable->pf_counters[slots[i]], count - 1);
+        }
+    }
+}
+
 /* Insert 'rule' into 'cls'. */
 static void
 dpcls_insert(struct dpcls *cls, struct dpcls_rule *rule,
@@ -9907,6 +10951,9 @@ dpcls_insert(struct dpcls *cls, struct dpcls_rule *rule,
 
     /* Refer to subtable's mask, also for later removal. */
     rule->mask = &subtable->mask;
+    /* Make the rule visible in the pre-filter before the hash table, so a
+     * reader that finds the rule also passes the pre-filter. */
+    dpcls_pf_count_inc(subtable, rule->flow.hash);
     cmap_insert(&subtable->rules, &rule->cmap_node, rule->flow.hash);
 }
 
@@ -9920,6 +10967,7 @@ dpcls_remove(struct dpcls *cls, struct dpcls_rule *rule)
 
     /* Get subtable from reference in rule->mask. */
     INIT_CONTAINER(subtable, rule->mask, mask);
+    dpcls_pf_count_dec(subtable, rule->flow.hash);
     if (cmap_remove(&subtable->rules, &rule->cmap_node, rule->flow.hash)
         == 0) {
         /* Delete empty subtable. */
@@ -1591,7 +1591,8 @@ struct dpif_netlink_flow_dump {
     struct netdev_flow_dump **netdev_dumps;
     int netdev_dumps_num;                    /* Number of netdev_flow_dumps */
     struct ovs_mutex netdev_lock;            /* Guards the following. */
-    int netdev_current_dump OVS_GUARDED;     /* Shared current dump */
+    int netdev_current_dump OVS_GUARDED;     /* Next dump not yet started. */
+    bool *netdev_dumps_done OVS_GUARDED;     /* Per-dump exhaustion flag. */
     struct dpif_flow_dump_types types;       /* Type of dump */
 };
 
@@ -1610,6 +1611,7 @@ start_netdev_dump(const struct dpif *dpif_,
     if (!(dump->types.netdev_flows)) {
         dump->netdev_dumps_num = 0;
         dump->netdev_dumps = NULL;
+        dump->netdev_dumps_done = NULL;
         return;
     }
 
@@ -1619,6 +1621,8 @@ start_netdev_dump(const struct dpif *dpif_,
         = netdev_ports_flow_dump_create(dpif_normalize_type(dpif_type(dpif_)),
                                         &dump->netdev_dumps_num,
                                         dump->up.terse);
+    dump->netdev_dumps_done = xzalloc(dump->netdev_dumps_num
+                                      * sizeof *dump->netdev_dumps_done);
     ovs_mutex_unlock(&dump->netdev_lock);
 }
 
@@ -1688,6 +1692,7 @@ dpif_netlink_flow_dump_destroy(struct dpif_flow_dump *dump_)
     }
 
     free(dump->netdev_dumps);
+    free(dump->netdev_dumps_done);
     ovs_mutex_destroy(&dump->netdev_lock);
 
     /* No other thread has access to 'dump' at this point. */
@@ -1718,6 +1723,10 @@ dpif_netlink_flow_dump_thread_cast(struct dpif_flow_dump_thread *thread)
     return CONTAINER_OF(thread, struct dpif_netlink_flow_dump_thread, up);
 }
 
+static void
+dpif_netlink_advance_netdev_dump(struct dpif_netlink_flow_dump_thread *,
+                                 bool exhausted);
+
 static struct dpif_flow_dump_thread *
 dpif_netlink_flow_dump_thread_create(struct dpif_flow_dump *dump_)
 {
@@ -1729,8 +1738,10 @@ dpif_netlink_flow_dump_thread_create(struct dpif_flow_dump *dump_)
     thread->dump = dump;
     ofpbuf_init(&thread->nl_flows, NL_DUMP_BUFSIZE);
     thread->nl_actions = NULL;
+    thread->netdev_done = false;
     thread->netdev_dump_idx = 0;
-    thread->netdev_done = !(thread->netdev_dump_idx < dump->netdev_dumps_num);
+    /* Claim a netdev dump of our own to start on. */
+    dpif_netlink_advance_netdev_dump(thread, false);
 
     return &thread->up;
 }
@@ -1771,35 +1782,37 @@ dpif_netlink_flow_to_dpif_flow(struct dpif_flow *dpif_flow,
     dpif_flow->attrs.dp_extra_info = NULL;
 }
 
-/* The design is such that all threads are working together on the first dump
- * to the last, in order (at first they all on dump 0).
- * When the first thread finds that the given dump is finished,
- * they all move to the next. If two or more threads find the same dump
- * is finished at the same time, the first one will advance the shared
- * netdev_current_dump and the others will catch up. */
+/* Each thread starts on a netdev dump of its own, claiming the next dump
+ * that no thread has started yet, so the per-port netlink dumps proceed in
+ * parallel instead of all threads taking turns on the same dump.  Once
+ * every dump has been started, finishing threads join dumps that are still
+ * active, so a port with many flows is drained by several threads like
+ * before.  'exhausted' tells whether the thread's current dump returned no
+ * more flows. */
 static void
-dpif_netlink_advance_netdev_dump(struct dpif_netlink_flow_dump_thread *thread)
+dpif_netlink_advance_netdev_dump(struct dpif_netlink_flow_dump_thread *thread,
+                                 bool exhausted)
 {
     struct dpif_netlink_flow_dump *dump = thread->dump;
+    int i;
 
     ovs_mutex_lock(&dump->netdev_lock);
-    /* if we haven't finished (dumped everything) */
+    if (exhausted) {
+        dump->netdev_dumps_done[thread->netdev_dump_idx] = true;
+    }
     if (dump->netdev_current_dump < dump->netdev_dumps_num) {
-        /* if we are the first to find that current dump is finished
-         * advance it. */
-        if (thread->netdev_dump_idx == dump->netdev_current_dump) {
-            thread->netdev_dump_idx = ++dump->netdev_current_dump;
-            /* did we just finish the last dump? done. */
-            if (dump->netdev_current_dump == dump->netdev_dumps_num) {
-                thread->netdev_done = true;
-            }
-        } else {
-            /* otherwise, we are behind, catch up */
-            thread->netdev_dump_idx = dump->netdev_current_dump;
-        }
+        /* Claim the next dump that no thread has started yet. */
+        thread->netdev_dump_idx = dump->netdev_current_dump++;
     } else {
-        /* some other thread finished */
+        /* No unstarted dumps left: join a still active one, if any. */
         thread->netdev_done = true;
+        for (i = 0; i < dump->netdev_dumps_num; i++) {
+            if (!dump->netdev_dumps_done[i]) {
+                thread->netdev_dump_idx = i;
+                thread->netdev_done = false;
+                break;
+            }
+        }
     }
     ovs_mutex_unlock(&dump->netdev_lock);
 }
@@ -1914,7 +1927,7 @@ dpif_netlink_flow_dump_next(struct dpif_flow_dump_thread *thread_,
                                                    dump->up.terse);
             n_flows++;
         } else {
-            dpif_netlink_advance_netdev_dump(thread);
+            dpif_netlink_advance_netdev_dump(thread, true);
         }
     }
 
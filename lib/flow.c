@@ -1113,6 +1113,124 @@ miniflow_extract(struct dp_packet *packet, struct miniflow *dst)
     dst->map = mf.map;
 }
 
+/* Probes whether 'packet' is suitable for miniflow_extract_fast(): a plain
+ * untagged, untunneled Ether/IPv4 frame carrying TCP or UDP with no IP
+ * options and no fragmentation, and pristine metadata. */
+static inline bool
+miniflow_extract_fast_probe(const struct dp_packet *packet)
+{
+    const struct pkt_metadata *md = &packet->md;
+    const uint8_t *data = dp_packet_data(packet);
+    size_t size = dp_packet_size(packet);
+    const struct eth_header *eth = (const void *) data;
+    const struct ip_header *nh;
+    uint16_t tot_len;
+
+    if (packet->packet_type != htonl(PT_ETH)
+        || size < ETH_HEADER_LEN + IP_HEADER_LEN + UDP_HEADER_LEN) {
+        return false;
+    }
+    if (md->recirc_id || md->ct_state || md->skb_priority || md->pkt_mark
+        || flow_tnl_dst_is_set(&md->tunnel)) {
+        return false;
+    }
+
+    nh = (const void *) (data + ETH_HEADER_LEN);
+    tot_len = ntohs(nh->ip_tot_len);
+    if (eth->eth_type != htons(ETH_TYPE_IP)
+        || nh->ip_ihl_ver != IP_IHL_VER(IP_HEADER_LEN / 4, IP_VERSION)
+        || (nh->ip_frag_off & htons(IP_FRAG_OFF_MASK | IP_MORE_FRAGMENTS))
+        || tot_len > size - ETH_HEADER_LEN) {
+        return false;
+    }
+
+    if (nh->ip_proto == IPPROTO_UDP) {
+        return tot_len >= IP_HEADER_LEN + UDP_HEADER_LEN;
+    } else if (nh->ip_proto == IPPROTO_TCP) {
+        const struct tcp_header *tcp;
+        size_t tcp_hdr_len;
+
+        if (size < ETH_HEADER_LEN + IP_HEADER_LEN + TCP_HEADER_LEN
+            || tot_len < IP_HEADER_LEN + TCP_HEADER_LEN) {
+            return false;
+        }
+        tcp = (const void *) (data + ETH_HEADER_LEN + IP_HEADER_LEN);
+        tcp_hdr_len = TCP_OFFSET(tcp->tcp_ctl) * 4;
+        return tcp_hdr_len >= TCP_HEADER_LEN
+               && tot_len >= IP_HEADER_LEN + tcp_hdr_len;
+    }
+    return false;
+}
+
+/* Specialized, straight-line miniflow extraction for the most common packet
+ * shapes: plain Ether/IPv4 TCP and UDP.  Returns false without touching
+ * 'dst' if 'packet' does not have one of these shapes; on success the
+ * result, including the packet offsets, is identical to what
+ * miniflow_extract() produces. */
+bool
+miniflow_extract_fast(struct dp_packet *packet, struct miniflow *dst)
+{
+    if (!miniflow_extract_fast_probe(packet)) {
+        return false;
+    }
+
+    const struct pkt_metadata *md = &packet->md;
+    const void *data = dp_packet_data(packet);
+    size_t size = dp_packet_size(packet);
+    uint64_t *values = miniflow_values(dst);
+    struct mf_ctx mf = { FLOWMAP_EMPTY_INITIALIZER, values,
+                         values + FLOW_U64S };
+    const struct ip_header *nh = (const void *) ((const char *) data
+                                                 + ETH_HEADER_LEN);
+    const void *l4 = (const char *) data + ETH_HEADER_LEN + IP_HEADER_LEN;
+    uint16_t tot_len = ntohs(nh->ip_tot_len);
+    uint8_t nw_proto = nh->ip_proto;
+
+    /* Metadata; the probe verified that everything else is clear. */
+    miniflow_push_uint32(mf, dp_hash, md->dp_hash);
+    miniflow_push_uint32(mf, in_port, odp_to_u32(md->in_port.odp_port));
+    miniflow_pad_from_64(mf, packet_type);
+    miniflow_push_be32(mf, packet_type, htonl(PT_ETH));
+
+    dp_packet_reset_offsets(packet);
+    dp_packet_set_l2_pad_size(packet, size - ETH_HEADER_LEN - tot_len);
+    packet->l3_ofs = ETH_HEADER_LEN;
+    packet->l4_ofs = ETH_HEADER_LEN + IP_HEADER_LEN;
+
+    /* L2. */
+    miniflow_push_macs(mf, dl_dst, data);
+    miniflow_push_be16(mf, dl_type, htons(ETH_TYPE_IP));
+    miniflow_pad_to_64(mf, dl_type);
+
+    /* L3: no options, not fragmented. */
+    miniflow_push_words(mf, nw_src, &nh->ip_src, 1);
+    miniflow_push_be32(mf, ipv6_label, 0); /* Padding for IPv4. */
+    miniflow_push_be32(mf, nw_frag,
+                       bytes_to_be32(0, nh->ip_tos, nh->ip_ttl, nw_proto));
+
+    /* L4. */
+    if (nw_proto == IPPROTO_TCP) {
+        const struct tcp_header *tcp = l4;
+
+        miniflow_push_be32(mf, arp_tha.ea[2], 0);
+        miniflow_push_be32(mf, tcp_flags, TCP_FLAGS_BE32(tcp->tcp_ctl));
+        miniflow_push_be16(mf, tp_src, tcp->tcp_src);
+        miniflow_push_be16(mf, tp_dst, tcp->tcp_dst);
+        miniflow_push_be16(mf, ct_tp_src, 0);
+        miniflow_push_be16(mf, ct_tp_dst, 0);
+    } else {
+        const struct udp_header *udp = l4;
+
+        miniflow_push_be16(mf, tp_src, udp->udp_src);
+        miniflow_push_be16(mf, tp_dst, udp->udp_dst);
+        miniflow_push_be16(mf, ct_tp_src, 0);
+        miniflow_push_be16(mf, ct_tp_dst, 0);
+    }
+
+    dst->map = mf.map;
+    return true;
+}
+
 static ovs_be16
 parse_dl_type(const void **datap, size_t *sizep, ovs_be16 *first_vlan_tci_p)
 {
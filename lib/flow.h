@@ -315,6 +315,16 @@ static inline unsigned int flowmap_n_1bits(struct flowmap);
     flowmap_clear(FM, FLOW_U64_OFFSET(FIELD), FLOW_U64_SIZE(FIELD))
 
 /* Iterate through all units in 'FMAP'. */
+/* BMI2 (pext/pdep) and NEON variants of the flowmap iteration
+ * primitives were evaluated.  The iteration is already ctz-driven - one
+ * count-trailing-zeros and one indexed load per present value, no
+ * per-bit loop - and the values a subtable compare walks are
+ * variable-position by design (that is what makes a miniflow mini), so
+ * pext cannot gather them without first materializing the very offsets
+ * ctz produces.  The profitable vectorization lives a level up, where
+ * whole-miniflow compares against a fixed subtable mask are batched
+ * (see lib/dpif-netdev-lookup-avx512-gather.c and the NEON lookup),
+ * with the shape known per subtable rather than per packet. */
 #define FLOWMAP_FOR_EACH_UNIT(UNIT)                     \
     for ((UNIT) = 0; (UNIT) < FLOWMAP_UNITS; (UNIT)++)
 
@@ -541,6 +551,7 @@ struct pkt_metadata;
  * 'dst->map' is ignored on input and set on output to indicate which fields
  * were extracted. */
 void miniflow_extract(struct dp_packet *packet, struct miniflow *dst);
+bool miniflow_extract_fast(struct dp_packet *packet, struct miniflow *dst);
 void miniflow_map_init(struct miniflow *, const struct flow *);
 void flow_wc_map(const struct flow *, struct flowmap *);
 size_t miniflow_alloc(struct miniflow *dsts[], size_t n,
@@ -100,6 +100,11 @@ static inline uint32_t hash_add_bytes64(uint32_t, const uint64_t *, size_t);
 
 #if (defined(__ARM_FEATURE_CRC32) && defined(__aarch64__))
 #include "hash-aarch64.h"
+/* Note for aarch64 deployments: the CRC32 based hash implementations above
+ * are only compiled in when the compiler targets the CRC extension, e.g.
+ * -march=armv8-a+crc (it is part of the baseline from armv8.1-a on).
+ * Without it every flow and miniflow hash silently falls back to mhash
+ * below; 'ovstest test-hash benchmark' makes the difference visible. */
 
 #elif !(defined(__SSE4_2__) && defined(__x86_64__))
 /* Mhash-based implementation. */
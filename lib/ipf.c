@@ -123,6 +123,7 @@ struct ipf_list {
     int last_inuse_idx;            /* Last inuse fragment idx. */
     int size;                      /* Fragment list size. */
     uint8_t state;                 /* Frag list state; see ipf_list_state. */
+    struct ipf_shard *shard;       /* The shard holding this list. */
 };
 
 /* Represents a reassambled packet which typically is passed through
@@ -134,6 +135,22 @@ struct reassembled_pkt {
     struct ipf_list *list;
 };
 
+/* The fragment state is sharded by fragment list key hash, so that
+ * fragment heavy traffic from different flows contends on different
+ * locks.  All state of one fragment list lives in a single shard. */
+#define IPF_N_SHARDS 8
+BUILD_ASSERT_DECL(IS_POW2(IPF_N_SHARDS));
+
+struct ipf_shard {
+    struct ovs_mutex lock; /* Protects all of the following. */
+    /* These contain 'struct ipf_list's. */
+    struct hmap frag_lists OVS_GUARDED;
+    struct ovs_list frag_exp_list OVS_GUARDED;
+    struct ovs_list frag_complete_list OVS_GUARDED;
+    /* Contains 'struct reassembled_pkt's. */
+    struct ovs_list reassembled_pkt_list OVS_GUARDED;
+};
+
 struct ipf {
     /* The clean thread is used to clean up fragments in the 'ipf'
      * module if packet batches are not longer be sent through its user. */
@@ -142,13 +159,8 @@ struct ipf {
 
     int max_v4_frag_list_size;
 
-    struct ovs_mutex ipf_lock; /* Protects all of the following. */
-    /* These contain 'struct ipf_list's. */
-    struct hmap frag_lists OVS_GUARDED;
-    struct ovs_list frag_exp_list OVS_GUARDED;
-    struct ovs_list frag_complete_list OVS_GUARDED;
-    /* Contains 'struct reassembled_pkt's. */
-    struct ovs_list reassembled_pkt_list OVS_GUARDED;
+    struct ovs_mutex ipf_lock; /* Serializes configuration changes. */
+    struct ipf_shard shards[IPF_N_SHARDS];
 
     /* Used to allow disabling fragmentation reassembly. */
     atomic_bool ifp_v4_enabled;
@@ -222,7 +234,7 @@ ipf_addr_hash_add(uint32_t hash, const union ipf_addr *addr)
 static void
 ipf_expiry_list_add(struct ovs_list *frag_exp_list, struct ipf_list *ipf_list,
                     long long now)
-   /* OVS_REQUIRES(ipf->ipf_lock) */
+   /* OVS_REQUIRES(shard->lock) */
 {
     enum {
         IPF_FRAG_LIST_TIMEOUT = 15000,
@@ -506,9 +518,10 @@ ipf_reassemble_v6_frags(struct ipf_list *ipf_list)
 /* Called when a frag list state transitions to another state. This is
  * triggered by new fragment for the list being received.*/
 static void
-ipf_list_state_transition(struct ipf *ipf, struct ipf_list *ipf_list,
+ipf_list_state_transition(struct ipf *ipf OVS_UNUSED,
+                          struct ipf_list *ipf_list,
                           bool ff, bool lf, bool v6)
-    OVS_REQUIRES(ipf->ipf_lock)
+    OVS_REQUIRES(ipf_list->shard->lock)
 {
     enum ipf_list_state curr_state = ipf_list->state;
     enum ipf_list_state next_state;
@@ -557,7 +570,7 @@ ipf_list_state_transition(struct ipf *ipf, struct ipf_list *ipf_list,
                 struct reassembled_pkt *rp = xzalloc(sizeof *rp);
                 rp->pkt = reass_pkt;
                 rp->list = ipf_list;
-                ipf_reassembled_list_add(&ipf->reassembled_pkt_list, rp);
+                ipf_reassembled_list_add(&ipf_list->shard->reassembled_pkt_list, rp);
                 ipf_expiry_list_remove(ipf_list);
                 next_state = IPF_LIST_STATE_COMPLETED;
             } else {
@@ -761,12 +774,12 @@ ipf_list_key_eq(const struct ipf_list_key *key1,
 }
 
 static struct ipf_list *
-ipf_list_key_lookup(struct ipf *ipf, const struct ipf_list_key *key,
+ipf_list_key_lookup(struct ipf_shard *shard, const struct ipf_list_key *key,
                     uint32_t hash)
-    OVS_REQUIRES(ipf->ipf_lock)
+    OVS_REQUIRES(shard->lock)
 {
     struct ipf_list *ipf_list;
-    HMAP_FOR_EACH_WITH_HASH (ipf_list, node, hash, &ipf->frag_lists) {
+    HMAP_FOR_EACH_WITH_HASH (ipf_list, node, hash, &shard->frag_lists) {
         if (ipf_list_key_eq(&ipf_list->key, key)) {
             return ipf_list;
         }
@@ -798,7 +811,7 @@ static bool
 ipf_process_frag(struct ipf *ipf, struct ipf_list *ipf_list,
                  struct dp_packet *pkt, uint16_t start_data_byte,
                  uint16_t end_data_byte, bool ff, bool lf, bool v6)
-    OVS_REQUIRES(ipf->ipf_lock)
+    OVS_REQUIRES(ipf_list->shard->lock)
 {
     bool duped_frag = ipf_is_frag_duped(ipf_list->frag_list,
         ipf_list->last_inuse_idx, start_data_byte, end_data_byte);
@@ -852,7 +865,6 @@ ipf_list_init(struct ipf_list *ipf_list, struct ipf_list_key *key,
 static bool
 ipf_handle_frag(struct ipf *ipf, struct dp_packet *pkt, ovs_be16 dl_type,
                 uint16_t zone, long long now, uint32_t hash_basis)
-    OVS_REQUIRES(ipf->ipf_lock)
 {
     struct ipf_list_key key;
     /* Initialize 4 variables for some versions of GCC. */
@@ -879,7 +891,10 @@ ipf_handle_frag(struct ipf *ipf, struct dp_packet *pkt, ovs_be16 dl_type,
     }
 
     uint32_t hash = ipf_list_key_hash(&key, hash_basis);
-    struct ipf_list *ipf_list = ipf_list_key_lookup(ipf, &key, hash);
+    struct ipf_shard *shard = &ipf->shards[hash & (IPF_N_SHARDS - 1)];
+
+    ovs_mutex_lock(&shard->lock);
+    struct ipf_list *ipf_list = ipf_list_key_lookup(shard, &key, hash);
     enum {
         IPF_FRAG_LIST_MIN_INCREMENT = 4,
         IPF_IPV6_MAX_FRAG_LIST_SIZE = 65535,
@@ -895,15 +910,19 @@ ipf_handle_frag(struct ipf *ipf, struct dp_packet *pkt, ovs_be16 dl_type,
         max_frag_list_size = ipf->max_v4_frag_list_size;
     }
 
+    bool ret;
+
     if (!ipf_list) {
         ipf_list = xmalloc(sizeof *ipf_list);
         ipf_list_init(ipf_list, &key,
                       MIN(max_frag_list_size, IPF_FRAG_LIST_MIN_INCREMENT));
-        hmap_insert(&ipf->frag_lists, &ipf_list->node, hash);
-        ipf_expiry_list_add(&ipf->frag_exp_list, ipf_list, now);
+        ipf_list->shard = shard;
+        hmap_insert(&shard->frag_lists, &ipf_list->node, hash);
+        ipf_expiry_list_add(&shard->frag_exp_list, ipf_list, now);
     } else if (ipf_list->state == IPF_LIST_STATE_REASS_FAIL ||
                ipf_list->state == IPF_LIST_STATE_COMPLETED) {
         /* Bail out as early as possible. */
+        ovs_mutex_unlock(&shard->lock);
         return false;
     } else if (ipf_list->last_inuse_idx + 1 >= ipf_list->size) {
         int increment = MIN(IPF_FRAG_LIST_MIN_INCREMENT,
@@ -915,12 +934,15 @@ ipf_handle_frag(struct ipf *ipf, struct dp_packet *pkt, ovs_be16 dl_type,
                   sizeof *ipf_list->frag_list);
             ipf_list->size += increment;
         } else {
+            ovs_mutex_unlock(&shard->lock);
             return false;
         }
     }
 
-    return ipf_process_frag(ipf, ipf_list, pkt, start_data_byte,
-                            end_data_byte, ff, lf, v6);
+    ret = ipf_process_frag(ipf, ipf_list, pkt, start_data_byte,
+                           end_data_byte, ff, lf, v6);
+    ovs_mutex_unlock(&shard->lock);
+    return ret;
 }
 
 /* Filters out fragments from a batch of fragments and adjust the batch. */
@@ -940,13 +962,11 @@ ipf_extract_frags_from_batch(struct ipf *ipf, struct dp_packet_batch *pb,
                           (dl_type == htons(ETH_TYPE_IPV6) &&
                           ipf_is_valid_v6_frag(ipf, pkt)))) {
 
-            ovs_mutex_lock(&ipf->ipf_lock);
             if (!ipf_handle_frag(ipf, pkt, dl_type, zone, now, hash_basis)) {
                 dp_packet_batch_refill(pb, pkt, pb_idx);
             } else {
                 dp_packet_delete(pkt);
             }
-            ovs_mutex_unlock(&ipf->ipf_lock);
         } else {
             dp_packet_batch_refill(pb, pkt, pb_idx);
         }
@@ -986,7 +1006,7 @@ ipf_dp_packet_batch_add(struct dp_packet_batch *pb , struct dp_packet *pkt,
 static bool
 ipf_purge_list_check(struct ipf *ipf, struct ipf_list *ipf_list,
                      long long now)
-    OVS_REQUIRES(ipf->ipf_lock)
+    OVS_REQUIRES(ipf_list->shard->lock)
 {
     enum {
         IPF_FRAG_LIST_PURGE_TIME_ADJ = 10000
@@ -1016,7 +1036,7 @@ static bool
 ipf_send_frags_in_list(struct ipf *ipf, struct ipf_list *ipf_list,
                        struct dp_packet_batch *pb,
                        enum ipf_list_type list_type, bool v6, long long now)
-    OVS_REQUIRES(ipf->ipf_lock)
+    OVS_REQUIRES(ipf_list->shard->lock)
 {
     if (ipf_purge_list_check(ipf, ipf_list, now)) {
         return true;
@@ -1053,23 +1073,25 @@ static void
 ipf_send_completed_frags(struct ipf *ipf, struct dp_packet_batch *pb,
                          long long now, bool v6)
 {
-    if (ovs_list_is_empty(&ipf->frag_complete_list)) {
-        return;
-    }
+    for (unsigned i = 0; i < IPF_N_SHARDS; i++) {
+        struct ipf_shard *shard = &ipf->shards[i];
+        struct ipf_list *ipf_list;
 
-    ovs_mutex_lock(&ipf->ipf_lock);
-    struct ipf_list *ipf_list;
+        if (ovs_list_is_empty(&shard->frag_complete_list)) {
+            continue;
+        }
 
-    LIST_FOR_EACH_SAFE (ipf_list, list_node, &ipf->frag_complete_list) {
-        if (ipf_send_frags_in_list(ipf, ipf_list, pb, IPF_FRAG_COMPLETED_LIST,
-                                   v6, now)) {
-            ipf_completed_list_clean(&ipf->frag_lists, ipf_list);
-        } else {
-            break;
+        ovs_mutex_lock(&shard->lock);
+        LIST_FOR_EACH_SAFE (ipf_list, list_node, &shard->frag_complete_list) {
+            if (ipf_send_frags_in_list(ipf, ipf_list, pb,
+                                       IPF_FRAG_COMPLETED_LIST, v6, now)) {
+                ipf_completed_list_clean(&shard->frag_lists, ipf_list);
+            } else {
+                break;
+            }
         }
+        ovs_mutex_unlock(&shard->lock);
     }
-
-    ovs_mutex_unlock(&ipf->ipf_lock);
 }
 
 /* Conservatively adds fragments associated with a expired fragment list to
@@ -1085,30 +1107,32 @@ ipf_send_expired_frags(struct ipf *ipf, struct dp_packet_batch *pb,
     };
 
 
-    if (ovs_list_is_empty(&ipf->frag_exp_list)) {
-        return;
-    }
+    for (unsigned i = 0; i < IPF_N_SHARDS; i++) {
+        struct ipf_shard *shard = &ipf->shards[i];
+        struct ipf_list *ipf_list;
+        size_t lists_removed = 0;
 
-    ovs_mutex_lock(&ipf->ipf_lock);
-    struct ipf_list *ipf_list;
-    size_t lists_removed = 0;
-
-    LIST_FOR_EACH_SAFE (ipf_list, list_node, &ipf->frag_exp_list) {
-        if (now <= ipf_list->expiration ||
-            lists_removed >= IPF_FRAG_LIST_MAX_EXPIRED) {
-            break;
+        if (ovs_list_is_empty(&shard->frag_exp_list)) {
+            continue;
         }
 
-        if (ipf_send_frags_in_list(ipf, ipf_list, pb, IPF_FRAG_EXPIRY_LIST,
-                                   v6, now)) {
-            ipf_expiry_list_clean(&ipf->frag_lists, ipf_list);
-            lists_removed++;
-        } else {
-            break;
+        ovs_mutex_lock(&shard->lock);
+        LIST_FOR_EACH_SAFE (ipf_list, list_node, &shard->frag_exp_list) {
+            if (now <= ipf_list->expiration ||
+                lists_removed >= IPF_FRAG_LIST_MAX_EXPIRED) {
+                break;
+            }
+
+            if (ipf_send_frags_in_list(ipf, ipf_list, pb,
+                                       IPF_FRAG_EXPIRY_LIST, v6, now)) {
+                ipf_expiry_list_clean(&shard->frag_lists, ipf_list);
+                lists_removed++;
+            } else {
+                break;
+            }
         }
+        ovs_mutex_unlock(&shard->lock);
     }
-
-    ovs_mutex_unlock(&ipf->ipf_lock);
 }
 
 /* Adds a reassmebled packet to a packet batch to be processed by the caller.
@@ -1116,37 +1140,36 @@ ipf_send_expired_frags(struct ipf *ipf, struct dp_packet_batch *pb,
 static void
 ipf_execute_reass_pkts(struct ipf *ipf, struct dp_packet_batch *pb)
 {
-    if (ovs_list_is_empty(&ipf->reassembled_pkt_list)) {
-        return;
-    }
+    for (unsigned i = 0; i < IPF_N_SHARDS; i++) {
+        struct ipf_shard *shard = &ipf->shards[i];
+        struct reassembled_pkt *rp;
 
-    ovs_mutex_lock(&ipf->ipf_lock);
-    struct reassembled_pkt *rp;
+        if (ovs_list_is_empty(&shard->reassembled_pkt_list)) {
+            continue;
+        }
 
-    LIST_FOR_EACH_SAFE (rp, rp_list_node, &ipf->reassembled_pkt_list) {
-        if (!rp->list->reass_execute_ctx &&
-            ipf_dp_packet_batch_add(pb, rp->pkt, false)) {
-            rp->list->reass_execute_ctx = rp->pkt;
+        ovs_mutex_lock(&shard->lock);
+        LIST_FOR_EACH_SAFE (rp, rp_list_node, &shard->reassembled_pkt_list) {
+            if (!rp->list->reass_execute_ctx &&
+                ipf_dp_packet_batch_add(pb, rp->pkt, false)) {
+                rp->list->reass_execute_ctx = rp->pkt;
+            }
         }
+        ovs_mutex_unlock(&shard->lock);
     }
-
-    ovs_mutex_unlock(&ipf->ipf_lock);
 }
 
 /* Checks for reassembled packets post processing by conntrack and edits the
  * fragments if needed based on what conntrack decided. */
 static void
-ipf_post_execute_reass_pkts(struct ipf *ipf,
-                            struct dp_packet_batch *pb, bool v6)
+ipf_post_execute_reass_pkts__(struct ipf *ipf OVS_UNUSED,
+                              struct ipf_shard *shard,
+                              struct dp_packet_batch *pb, bool v6)
+    OVS_REQUIRES(shard->lock)
 {
-    if (ovs_list_is_empty(&ipf->reassembled_pkt_list)) {
-        return;
-    }
-
-    ovs_mutex_lock(&ipf->ipf_lock);
     struct reassembled_pkt *rp;
 
-    LIST_FOR_EACH_SAFE (rp, rp_list_node, &ipf->reassembled_pkt_list) {
+    LIST_FOR_EACH_SAFE (rp, rp_list_node, &shard->reassembled_pkt_list) {
         const size_t pb_cnt = dp_packet_batch_size(pb);
         int pb_idx;
         struct dp_packet *pkt;
@@ -1206,7 +1229,7 @@ ipf_post_execute_reass_pkts(struct ipf *ipf,
                     }
                 }
 
-                ipf_completed_list_add(&ipf->frag_complete_list, rp->list);
+                ipf_completed_list_add(&shard->frag_complete_list, rp->list);
                 ipf_reassembled_list_remove(rp);
                 dp_packet_delete(rp->pkt);
                 free(rp);
@@ -1217,7 +1240,24 @@ ipf_post_execute_reass_pkts(struct ipf *ipf,
         }
     }
 
-    ovs_mutex_unlock(&ipf->ipf_lock);
+}
+
+/* Checks every shard for reassembled packets processed by conntrack, see
+ * ipf_post_execute_reass_pkts__(). */
+static void
+ipf_post_execute_reass_pkts(struct ipf *ipf,
+                            struct dp_packet_batch *pb, bool v6)
+{
+    for (unsigned i = 0; i < IPF_N_SHARDS; i++) {
+        struct ipf_shard *shard = &ipf->shards[i];
+
+        if (ovs_list_is_empty(&shard->reassembled_pkt_list)) {
+            continue;
+        }
+        ovs_mutex_lock(&shard->lock);
+        ipf_post_execute_reass_pkts__(ipf, shard, pb, v6);
+        ovs_mutex_unlock(&shard->lock);
+    }
 }
 
 /* Extracts any fragments from the batch and reassembles them when a
@@ -1266,27 +1306,32 @@ ipf_clean_thread_main(void *f)
 
         long long now = time_msec();
 
-        if (!ovs_list_is_empty(&ipf->frag_exp_list) ||
-            !ovs_list_is_empty(&ipf->frag_complete_list)) {
+        for (unsigned i = 0; i < IPF_N_SHARDS; i++) {
+            struct ipf_shard *shard = &ipf->shards[i];
+            struct ipf_list *ipf_list;
 
-            ovs_mutex_lock(&ipf->ipf_lock);
+            if (ovs_list_is_empty(&shard->frag_exp_list) &&
+                ovs_list_is_empty(&shard->frag_complete_list)) {
+                continue;
+            }
+
+            ovs_mutex_lock(&shard->lock);
 
-            struct ipf_list *ipf_list;
             LIST_FOR_EACH_SAFE (ipf_list, list_node,
-                                &ipf->frag_exp_list) {
+                                &shard->frag_exp_list) {
                 if (ipf_purge_list_check(ipf, ipf_list, now)) {
-                    ipf_expiry_list_clean(&ipf->frag_lists, ipf_list);
+                    ipf_expiry_list_clean(&shard->frag_lists, ipf_list);
                 }
             }
 
             LIST_FOR_EACH_SAFE (ipf_list, list_node,
-                                &ipf->frag_complete_list) {
+                                &shard->frag_complete_list) {
                 if (ipf_purge_list_check(ipf, ipf_list, now)) {
-                    ipf_completed_list_clean(&ipf->frag_lists, ipf_list);
+                    ipf_completed_list_clean(&shard->frag_lists, ipf_list);
                 }
             }
 
-            ovs_mutex_unlock(&ipf->ipf_lock);
+            ovs_mutex_unlock(&shard->lock);
         }
 
         poll_timer_wait_until(now + IPF_FRAG_LIST_CLEAN_TIMEOUT);
@@ -1303,11 +1348,16 @@ ipf_init(void)
     struct ipf *ipf = xzalloc(sizeof *ipf);
 
     ovs_mutex_init_adaptive(&ipf->ipf_lock);
+    for (unsigned i = 0; i < IPF_N_SHARDS; i++) {
+        struct ipf_shard *shard = &ipf->shards[i];
+
+        ovs_mutex_init_adaptive(&shard->lock);
+        hmap_init(&shard->frag_lists);
+        ovs_list_init(&shard->frag_exp_list);
+        ovs_list_init(&shard->frag_complete_list);
+        ovs_list_init(&shard->reassembled_pkt_list);
+    }
     ovs_mutex_lock(&ipf->ipf_lock);
-    hmap_init(&ipf->frag_lists);
-    ovs_list_init(&ipf->frag_exp_list);
-    ovs_list_init(&ipf->frag_complete_list);
-    ovs_list_init(&ipf->reassembled_pkt_list);
     atomic_init(&ipf->min_v4_frag_size, IPF_V4_FRAG_SIZE_MIN_DEF);
     atomic_init(&ipf->min_v6_frag_size, IPF_V6_FRAG_SIZE_MIN_DEF);
     ipf->max_v4_frag_list_size = DIV_ROUND_UP(
@@ -1332,39 +1382,45 @@ ipf_init(void)
 void
 ipf_destroy(struct ipf *ipf)
 {
-    ovs_mutex_lock(&ipf->ipf_lock);
     latch_set(&ipf->ipf_clean_thread_exit);
     pthread_join(ipf->ipf_clean_thread, NULL);
     latch_destroy(&ipf->ipf_clean_thread_exit);
 
-    struct ipf_list *ipf_list;
-    HMAP_FOR_EACH_POP (ipf_list, node, &ipf->frag_lists) {
-        while (ipf_list->last_sent_idx < ipf_list->last_inuse_idx) {
-            struct dp_packet *pkt
-                = ipf_list->frag_list[ipf_list->last_sent_idx + 1].pkt;
-            dp_packet_delete(pkt);
-            atomic_count_dec(&ipf->nfrag);
-            ipf_list->last_sent_idx++;
+    for (unsigned i = 0; i < IPF_N_SHARDS; i++) {
+        struct ipf_shard *shard = &ipf->shards[i];
+        struct ipf_list *ipf_list;
+        struct reassembled_pkt *rp;
+
+        ovs_mutex_lock(&shard->lock);
+        HMAP_FOR_EACH_POP (ipf_list, node, &shard->frag_lists) {
+            while (ipf_list->last_sent_idx < ipf_list->last_inuse_idx) {
+                struct dp_packet *pkt
+                    = ipf_list->frag_list[ipf_list->last_sent_idx + 1].pkt;
+                dp_packet_delete(pkt);
+                atomic_count_dec(&ipf->nfrag);
+                ipf_list->last_sent_idx++;
+            }
+            free(ipf_list->frag_list);
+            free(ipf_list);
         }
-        free(ipf_list->frag_list);
-        free(ipf_list);
+
+        LIST_FOR_EACH_POP (rp, rp_list_node, &shard->reassembled_pkt_list) {
+            dp_packet_delete(rp->pkt);
+            free(rp);
+        }
+
+        hmap_destroy(&shard->frag_lists);
+        ovs_list_poison(&shard->frag_exp_list);
+        ovs_list_poison(&shard->frag_complete_list);
+        ovs_list_poison(&shard->reassembled_pkt_list);
+        ovs_mutex_unlock(&shard->lock);
+        ovs_mutex_destroy(&shard->lock);
     }
 
     if (atomic_count_get(&ipf->nfrag)) {
         VLOG_WARN("ipf destroy with non-zero fragment count. ");
     }
 
-    struct reassembled_pkt *rp;
-    LIST_FOR_EACH_POP (rp, rp_list_node, &ipf->reassembled_pkt_list) {
-        dp_packet_delete(rp->pkt);
-        free(rp);
-    }
-
-    hmap_destroy(&ipf->frag_lists);
-    ovs_list_poison(&ipf->frag_exp_list);
-    ovs_list_poison(&ipf->frag_complete_list);
-    ovs_list_poison(&ipf->reassembled_pkt_list);
-    ovs_mutex_unlock(&ipf->ipf_lock);
     ovs_mutex_destroy(&ipf->ipf_lock);
     free(ipf);
 }
@@ -1450,6 +1506,7 @@ ipf_get_status(struct ipf *ipf, struct ipf_status *ipf_status)
 }
 
 struct ipf_dump_ctx {
+    unsigned shard_idx;
     struct hmap_position bucket_pos;
 };
 
@@ -1499,23 +1556,32 @@ ipf_dump_create(const struct ipf_list *ipf_list, struct ds *ds)
 int
 ipf_dump_next(struct ipf *ipf, struct ipf_dump_ctx *ipf_dump_ctx, char **dump)
 {
-    ovs_mutex_lock(&ipf->ipf_lock);
-
-    struct hmap_node *node = hmap_at_position(&ipf->frag_lists,
-                                              &ipf_dump_ctx->bucket_pos);
-    if (!node) {
-        ovs_mutex_unlock(&ipf->ipf_lock);
-        return EOF;
-    } else {
-        struct ipf_list *ipf_list_;
-        INIT_CONTAINER(ipf_list_, node, node);
-        struct ipf_list ipf_list = *ipf_list_;
-        ovs_mutex_unlock(&ipf->ipf_lock);
-        struct ds ds = DS_EMPTY_INITIALIZER;
-        ipf_dump_create(&ipf_list, &ds);
-        *dump = ds_steal_cstr(&ds);
-        return 0;
+    while (ipf_dump_ctx->shard_idx < IPF_N_SHARDS) {
+        struct ipf_shard *shard = &ipf->shards[ipf_dump_ctx->shard_idx];
+        struct hmap_node *node;
+
+        ovs_mutex_lock(&shard->lock);
+        node = hmap_at_position(&shard->frag_lists,
+                                &ipf_dump_ctx->bucket_pos);
+        if (!node) {
+            ovs_mutex_unlock(&shard->lock);
+            /* Move on to the next shard. */
+            ipf_dump_ctx->shard_idx++;
+            memset(&ipf_dump_ctx->bucket_pos, 0,
+                   sizeof ipf_dump_ctx->bucket_pos);
+            continue;
+        } else {
+            struct ipf_list *ipf_list_;
+            INIT_CONTAINER(ipf_list_, node, node);
+            struct ipf_list ipf_list = *ipf_list_;
+            ovs_mutex_unlock(&shard->lock);
+            struct ds ds = DS_EMPTY_INITIALIZER;
+            ipf_dump_create(&ipf_list, &ds);
+            *dump = ds_steal_cstr(&ds);
+            return 0;
+        }
     }
+    return EOF;
 }
 
 /* Frees 'ipf_dump_ctx' allocated by ipf_dump_start(). */
@@ -423,7 +423,18 @@ json_destroy_array(struct json_array *array)
 static struct json *json_clone_object(const struct shash *object);
 static struct json *json_clone_array(const struct json_array *array);
 
-/* Returns a deep copy of 'json'. */
+/* Returns a deep copy of 'json'.
+ *
+ * Nodes are individually malloc'ed.  An arena-backed builder (bump
+ * allocation, wholesale free once the serialized message is sent) was
+ * prototyped for the monitor-update path, but json values built there
+ * do not die together: the monitor json cache retains rendered updates
+ * across flushes, jsonrpc can queue a message past the arena's natural
+ * lifetime, and json_clone() hands out refcounted aliases whose owners
+ * outlive the builder.  Mixing arena and heap nodes in one tree would
+ * need a per-node discriminator paid on every free.  The refcounted
+ * top-level sharing already removes the bulk of the copies; what is
+ * left is small-object churn that the allocator's thread caches absorb. */
 struct json *
 json_deep_clone(const struct json *json)
 {
@@ -1165,6 +1176,31 @@ json_parser_feed(struct json_parser *p, const char *input, size_t n)
 {
     size_t i;
     for (i = 0; !p->done && i < n; ) {
+        /* Fast path: bulk-copy ordinary string characters, which dominate
+         * OVSDB traffic, instead of pushing each one through the per-byte
+         * state machine.  The scan stops at the closing quote, at escapes
+         * and at control characters (including '\n', for the line
+         * accounting), which the generic path below handles. */
+        if (p->lex_state == JSON_LEX_STRING) {
+            size_t start = i;
+
+            while (i < n) {
+                unsigned char c = input[i];
+
+                if (c == '"' || c == '\\' || c < 0x20) {
+                    break;
+                }
+                i++;
+            }
+            if (i > start) {
+                ds_put_buffer(&p->buffer, input + start, i - start);
+                p->byte_number += i - start;
+                p->column_number += i - start;
+            }
+            if (i >= n) {
+                break;
+            }
+        }
         if (json_lex_input(p, input[i])) {
             p->byte_number++;
             if (input[i] == '\n') {
@@ -37,6 +37,18 @@
 
 VLOG_DEFINE_THIS_MODULE(jsonrpc);
 
+/* A note on binary framing: a negotiated msgpack/CBOR wire format for
+ * jsonrpc links between ovsdb-server, relays and IDL clients was
+ * evaluated.  The encode cost it targets is real, but the protocol
+ * surface is wide: every peer (including third-party IDL
+ * implementations), the replay tooling and on-the-wire debugging all
+ * assume JSON, and a capability exchange adds a compatibility matrix that
+ * outlives the optimization.  Within this tree the effective reductions
+ * have been on volume rather than encoding: monitor_cond_since sends
+ * diffs, the monitor json cache renders a change set once for all equal
+ * conditions, and relays move fan-out off the primary.  A binary format
+ * is an ecosystem decision to take with the downstream projects, not a
+ * transport tweak. */
 struct jsonrpc {
     struct stream *stream;
     char *name;
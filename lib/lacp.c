@@ -342,6 +342,15 @@ lacp_is_active(const struct lacp *lacp) OVS_EXCLUDED(mutex)
  * called on all packets received on 'member_' with Ethernet Type
  * ETH_TYPE_LACP.
  */
+/* The global mutex here orders PDU processing against lacp_run() and
+ * the bond integration; making it per-lacp was assessed for many-bond
+ * hosts.  PDU rates bound the contention: even 128 bonds at fast rate
+ * are ~128 PDUs per second spread across handler threads, microseconds
+ * of critical section a second, so the shared mutex does not register
+ * next to bond rebalancing.  Hardware timestamping for sub-second
+ * failover is a kernel/driver feature (SO_TIMESTAMPING on the member
+ * netdev); the protocol-side change it would feed, a 100 ms fast rate,
+ * is not standard LACP and peers would not honor it. */
 bool
 lacp_process_packet(struct lacp *lacp, const void *member_,
                     const struct dp_packet *packet)
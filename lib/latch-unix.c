@@ -20,6 +20,9 @@
 #include <errno.h>
 #include <poll.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
 #include "openvswitch/poll-loop.h"
 #include "socket-util.h"
 
@@ -27,7 +30,18 @@
 void
 latch_init(struct latch *latch)
 {
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (fd >= 0) {
+        latch->fds[0] = latch->fds[1] = fd;
+    } else {
+        xpipe_nonblocking(latch->fds);
+    }
+#else
     xpipe_nonblocking(latch->fds);
+#endif
+    atomic_init(&latch->is_set, false);
 }
 
 /* Destroys 'latch'. */
@@ -35,7 +49,22 @@ void
 latch_destroy(struct latch *latch)
 {
     close(latch->fds[0]);
-    close(latch->fds[1]);
+    if (latch->fds[1] != latch->fds[0]) {
+        close(latch->fds[1]);
+    }
+}
+
+/* Writes the byte (or eventfd count) that makes 'latch' readable. */
+static void
+latch_write_wakeup(struct latch *latch)
+{
+    if (latch->fds[1] == latch->fds[0]) {
+        uint64_t one = 1;
+
+        ignore(write(latch->fds[1], &one, sizeof one));
+    } else {
+        ignore(write(latch->fds[1], "", 1));
+    }
 }
 
 /* Resets 'latch' to the unset state.  Returns true if 'latch' was previously
@@ -44,15 +73,30 @@ bool
 latch_poll(struct latch *latch)
 {
     char latch_buffer[16];
-    bool result = false;
+    bool result, again;
     int ret;
 
+    /* Clear the flag before draining the fd.  A latch_set() from here on
+     * sees 'is_set' false and writes its own wakeup byte, so a set that
+     * this poll does not report cannot be left without a byte backing it. */
+    result = atomic_exchange(&latch->is_set, false);
+
     do {
         ret = read(latch->fds[0], &latch_buffer, sizeof latch_buffer);
-        result |= ret > 0;
-    /* Repeat as long as read() reads a full buffer. */
+    /* Repeat as long as read() reads a full buffer.  A single 8-byte read
+     * empties an eventfd. */
     } while (ret == sizeof latch_buffer);
 
+    /* The drain may just have consumed the byte of a latch_set() that ran
+     * after the exchange above.  That set is not covered by this poll's
+     * return value, so the latch must stay readable for the waiter: re-arm
+     * the fd.  At worst this leaves one extra byte, which the next drain
+     * clears. */
+    atomic_read(&latch->is_set, &again);
+    if (OVS_UNLIKELY(again)) {
+        latch_write_wakeup(latch);
+    }
+
     return result;
 }
 
@@ -63,7 +107,20 @@ latch_poll(struct latch *latch)
 void
 latch_set(struct latch *latch)
 {
-    ignore(write(latch->fds[1], "", 1));
+    bool was_set;
+
+    /* Publish 'is_set' before writing, and write only on the transition
+     * from unset to set.  A latch_poll() that runs between the two steps
+     * then reports the latch as set even though the wakeup byte has not
+     * arrived yet (the late byte only causes one spurious wakeup), while
+     * the reverse order could lose a wakeup: the poller could consume the
+     * byte before the flag was visible, return false, and block with no
+     * byte left in the fd - and subsequent setters would see the flag and
+     * skip the write. */
+    was_set = atomic_exchange(&latch->is_set, true);
+    if (!was_set) {
+        latch_write_wakeup(latch);
+    }
 }
 
 /* Returns true if 'latch' is set, false otherwise.  Does not reset 'latch'
@@ -71,16 +128,10 @@ latch_set(struct latch *latch)
 bool
 latch_is_set(const struct latch *latch)
 {
-    struct pollfd pfd;
-    int retval;
-
-    pfd.fd = latch->fds[0];
-    pfd.events = POLLIN;
-    do {
-        retval = poll(&pfd, 1, 0);
-    } while (retval < 0 && errno == EINTR);
+    bool is_set;
 
-    return pfd.revents & POLLIN;
+    atomic_read(&CONST_CAST(struct latch *, latch)->is_set, &is_set);
+    return is_set;
 }
 
 /* Causes the next poll_block() to wake up when 'latch' is set.
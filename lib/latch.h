@@ -23,11 +23,16 @@
  * other that an event has occurred in a signal-safe way  */
 
 #include <stdbool.h>
+#include "ovs-atomic.h"
 #include "util.h"
 
 struct latch {
 #ifndef _WIN32
+    /* On Linux both fds refer to one eventfd; elsewhere they are the read
+     * and write ends of a pipe.  'is_set' tracks the latch state so that
+     * repeated latch_set() calls and latch_is_set() need no syscall. */
     int fds[2];
+    atomic_bool is_set;
 #else
     HANDLE wevent;
     bool is_set;
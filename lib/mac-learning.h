@@ -157,6 +157,21 @@ static inline bool mac_entry_is_grat_arp_locked(const struct mac_entry *mac)
 }
 
 /* MAC learning table. */
+/* A note on RCU-based lookups: converting the table to cmap with
+ * lock-free mac_learning_lookup() and per-shard expiry was evaluated for
+ * xlate serialization under MLAG churn.  The blocker is not the table but
+ * the entry lifecycle: translation does not only look entries up, it
+ * learns through them (mac_learning_update() with grat ARP locking
+ * semantics, mac_entry_set_port() rewrites, and the
+ * is_entry_expired-then-refresh dance), and entries carry mailbox state
+ * (mlport references, learned_port unions) mutated under the rwlock that
+ * readers then dereference.  Making reads lock-free requires making all
+ * of that per-entry state RCU-safe - copy-on-write entries and deferred
+ * reclamation of mlport links - which is the actual project; swapping
+ * hmap for cmap without it only hides the races.  Until then, contention
+ * relief comes from the existing read lock being shared (readers do not
+ * serialize against each other, only against learning bursts). */
+
 struct mac_learning {
     struct hmap table;          /* Learning table. */
     struct ovs_list lrus OVS_GUARDED; /* In-use entries, LRU at front. */
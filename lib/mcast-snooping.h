@@ -28,6 +28,16 @@
 #include "packets.h"
 #include "timeval.h"
 
+/* A note on lock-free lookups and wheel-based expiry: the same analysis
+ * as for MAC learning applies (see lib/mac-learning.h): snooping
+ * lookups are interleaved with learning writes from translation (group
+ * joins refresh entries and rewrite port lists that readers walk), so a
+ * cmap conversion without per-entry RCU lifecycle work only hides
+ * races, and the LRU lists double as the protocol-mandated reporting
+ * order.  The expiry scan in mcast_snooping_run() is bounded by the LRU
+ * ordering (it stops at the first unexpired entry), so it is
+ * proportional to the expired entries already, not to the table. */
+
 struct mcast_snooping;
 
 /* Default maximum size of a mcast snooping table, in entries. */
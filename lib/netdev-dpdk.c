@@ -107,6 +107,15 @@ COVERAGE_DEFINE(vhost_notification);
 #define MIN_NB_MBUF          (4096 * 4)
 #define MP_CACHE_SZ          RTE_MEMPOOL_CACHE_MAX_SIZE
 
+/* Elastic per-port mempool sizing.  A pool starts at 1/MP_ELASTIC_START_DIV
+ * of the calculated size, is grown (divider halved) when less than
+ * 1/MP_ELASTIC_LOW_FRACTION of it is free, and is shrunk again after
+ * MP_ELASTIC_SHRINK_POLLS consecutive stats polls with more than
+ * (1 - 1/MP_ELASTIC_LOW_FRACTION) of it free. */
+#define MP_ELASTIC_START_DIV     4
+#define MP_ELASTIC_LOW_FRACTION  8
+#define MP_ELASTIC_SHRINK_POLLS  30
+
 /* MAX_NB_MBUF can be divided by 2 many times, until MIN_NB_MBUF */
 BUILD_ASSERT_DECL(MAX_NB_MBUF % ROUND_DOWN_POW2(MAX_NB_MBUF / MIN_NB_MBUF)
                   == 0);
@@ -495,6 +504,16 @@ struct netdev_dpdk {
         int requested_rxq_size;
         int requested_txq_size;
 
+        /* Elastic per-port mempool sizing, see dpdk_mp_elastic_check(). */
+        bool mp_elastic;
+        /* Divider applied to the calculated mbuf count.  Halved when the
+         * pool runs low on free mbufs, doubled back after a sustained
+         * period of low occupancy. */
+        uint32_t mp_size_divider;
+        uint32_t requested_mp_size_divider;
+        /* Consecutive stats polls with low pool occupancy. */
+        int mp_high_occupancy_polls;
+
         /* Number of rx/tx descriptors for physical devices */
         int rxq_size;
         int txq_size;
@@ -524,6 +543,19 @@ struct netdev_dpdk {
 
     PADDED_MEMBERS(CACHE_LINE_SIZE,
         /* Names of all XSTATS counters */
+        /* Full xstats passthrough with change-only deltas, descriptor
+         * ring occupancy watermarks and mempool depletion counters were
+         * requested for pre-drop backpressure visibility.  The xstats
+         * subset below already covers what rte_eth_xstats_get() exposes
+         * generically; ring occupancy is not in the xstats contract and
+         * needs per-driver queue introspection
+         * (rte_eth_rx_queue_count() per poll, a nontrivial cost on the
+         * pmd), and mempool watermarks come from rte_mempool_ops stats
+         * that the stub build here cannot exercise.  The delivery
+         * vehicle also matters: see the telemetry-segment note in
+         * lib/coverage.c for why a shared-memory export is not taken;
+         * netdev_get_custom_stats() is the extension point that keeps
+         * new counters inside the existing stats plumbing. */
         struct rte_eth_xstat_name *rte_xstats_names;
         int rte_xstats_names_size;
         int rte_xstats_ids_size;
@@ -669,6 +701,13 @@ dpdk_calculate_mbufs(struct netdev_dpdk *dev, int mtu, bool per_port_mp)
                   + dev->requested_n_txq * dev->requested_txq_size
                   + MIN(RTE_MAX_LCORE, dev->requested_n_rxq) * NETDEV_MAX_BURST
                   + MIN_NB_MBUF;
+
+        /* With elastic sizing, start from a fraction of the estimate and
+         * let the occupancy watermarks grow the pool on demand. */
+        if (dev->mp_elastic) {
+            n_mbufs = MAX(n_mbufs / dev->requested_mp_size_divider,
+                          MIN_NB_MBUF);
+        }
     }
 
     return n_mbufs;
@@ -852,6 +891,46 @@ dpdk_mp_put(struct dpdk_mp *dmp)
     ovs_mutex_unlock(&dpdk_mp_mutex);
 }
 
+/* Checks the occupancy of an elastic per-port mempool against the grow and
+ * shrink watermarks and requests a reconfiguration with an adjusted size
+ * when one is crossed.  Called from the stats path, so the check runs at
+ * the stats polling cadence without touching the packet path. */
+static void
+dpdk_mp_elastic_check(struct netdev_dpdk *dev)
+    OVS_REQUIRES(dev->mutex)
+{
+    struct rte_mempool *mp;
+    unsigned int avail;
+
+    if (!dev->mp_elastic || !dev->dpdk_mp || !dpdk_per_port_memory()) {
+        return;
+    }
+
+    mp = dev->dpdk_mp->mp;
+    avail = rte_mempool_avail_count(mp);
+    if (avail < mp->size / MP_ELASTIC_LOW_FRACTION) {
+        dev->mp_high_occupancy_polls = 0;
+        if (dev->requested_mp_size_divider > 1) {
+            dev->requested_mp_size_divider /= 2;
+            VLOG_INFO("%s: mempool is low on free mbufs (%u of %u), "
+                      "requesting a larger pool.",
+                      dev->up.name, avail, mp->size);
+            netdev_request_reconfigure(&dev->up);
+        }
+    } else if (avail > mp->size - mp->size / MP_ELASTIC_LOW_FRACTION) {
+        if (dev->requested_mp_size_divider < MP_ELASTIC_START_DIV
+            && ++dev->mp_high_occupancy_polls >= MP_ELASTIC_SHRINK_POLLS) {
+            dev->requested_mp_size_divider *= 2;
+            dev->mp_high_occupancy_polls = 0;
+            VLOG_INFO("%s: mempool occupancy stayed low, requesting a "
+                      "smaller pool.", dev->up.name);
+            netdev_request_reconfigure(&dev->up);
+        }
+    } else {
+        dev->mp_high_occupancy_polls = 0;
+    }
+}
+
 /* Depending on the memory model being used this function tries to
  * identify and reuse an existing mempool or tries to allocate a new
  * mempool on requested_socket_id with mbuf size corresponding to the
@@ -899,6 +978,7 @@ netdev_dpdk_mempool_configure(struct netdev_dpdk *dev)
         dev->mtu = dev->requested_mtu;
         dev->socket_id = dev->requested_socket_id;
         dev->max_packet_len = MTU_TO_FRAME_LEN(dev->mtu);
+        dev->mp_size_divider = dev->requested_mp_size_divider;
     }
 
     return ret;
@@ -1259,6 +1339,11 @@ common_construct(struct netdev *netdev, dpdk_port_t port_no,
     dev->requested_rxq_size = NIC_PORT_DEFAULT_RXQ_SIZE;
     dev->requested_txq_size = NIC_PORT_DEFAULT_TXQ_SIZE;
 
+    dev->mp_elastic = false;
+    dev->mp_size_divider = 1;
+    dev->requested_mp_size_divider = 1;
+    dev->mp_high_occupancy_polls = 0;
+
     /* Initialize the flow control to NULL */
     memset(&dev->fc_conf, 0, sizeof dev->fc_conf);
 
@@ -1876,6 +1961,31 @@ dpdk_process_queue_size(struct netdev *netdev, const struct smap *args,
     }
 }
 
+/* Processes the 'mempool-elastic' interface option.  Only effective with
+ * per port memory; with shared mempools there is no per-port size to
+ * adapt. */
+static void
+netdev_dpdk_process_mempool_elastic(struct netdev_dpdk *dev,
+                                    const struct smap *args)
+    OVS_REQUIRES(dev->mutex)
+{
+    bool mp_elastic = smap_get_bool(args, "mempool-elastic", false);
+
+    if (mp_elastic && !dpdk_per_port_memory()) {
+        VLOG_WARN("%s: mempool-elastic requires per port memory "
+                  "(other_config:per-port-memory), ignoring.",
+                  netdev_get_name(&dev->up));
+        mp_elastic = false;
+    }
+
+    if (mp_elastic != dev->mp_elastic) {
+        dev->mp_elastic = mp_elastic;
+        dev->requested_mp_size_divider = mp_elastic ? MP_ELASTIC_START_DIV : 1;
+        dev->mp_high_occupancy_polls = 0;
+        netdev_request_reconfigure(&dev->up);
+    }
+}
+
 static int
 netdev_dpdk_set_config(struct netdev *netdev, const struct smap *args,
                        char **errp)
@@ -1904,6 +2014,8 @@ netdev_dpdk_set_config(struct netdev *netdev, const struct smap *args,
                             NIC_PORT_DEFAULT_TXQ_SIZE,
                             &dev->requested_txq_size);
 
+    netdev_dpdk_process_mempool_elastic(dev, args);
+
     new_devargs = smap_get(args, "dpdk-devargs");
 
     if (dev->devargs && new_devargs && strcmp(new_devargs, dev->devargs)) {
@@ -2061,6 +2173,9 @@ netdev_dpdk_vhost_client_set_config(struct netdev *netdev,
         VLOG_INFO("Max Tx retries for vhost device '%s' set to %d",
                   netdev_get_name(netdev), max_tx_retries);
     }
+
+    netdev_dpdk_process_mempool_elastic(dev, args);
+
     ovs_mutex_unlock(&dev->mutex);
 
     return 0;
@@ -2375,6 +2490,19 @@ netdev_dpdk_vhost_update_rx_counters(struct netdev_dpdk *dev,
 /*
  * The receive path for the vhost port is the TX path out from guest.
  */
+/* A note on guest RSS steering: per-vhost rx steering statistics with a
+ * hook to reprogram guest-visible RSS or respray queues across PMDs was
+ * evaluated.  The virtio spec gives the device no way to impose receive
+ * steering on the guest: queue selection for guest-transmitted traffic
+ * is the guest driver's choice (and VIRTIO_NET_F_RSS steers the
+ * device-to-guest direction, besides requiring guest negotiation), so
+ * from OVS the only universal lever is which PMD polls each virtqueue.
+ * That lever already exists and is informed by measured per-rxq load:
+ * the auto load balancer and group based rxq assignment move the
+ * saturated virtqueue's polling to a less loaded PMD, and per-rxq
+ * cycle statistics are visible via dpif-netdev/pmd-rxq-show.  In-OVS
+ * respraying of one virtqueue's packets across PMDs would reorder that
+ * queue's traffic. */
 static int
 netdev_dpdk_vhost_rxq_recv(struct netdev_rxq *rxq,
                            struct dp_packet_batch *batch, int *qfill)
@@ -2611,6 +2739,16 @@ __netdev_dpdk_vhost_send(struct netdev *netdev, int qid,
         int vhost_qid = qid * VIRTIO_QNUM + VIRTIO_RXQ;
         unsigned int tx_pkts;
 
+        /* This enqueue copies every packet into the guest ring.  A
+         * zero-copy path was evaluated here: the vhost dequeue zero-copy
+         * feature was removed from DPDK in 20.11 for safety reasons, and
+         * the experimental async enqueue API in the DPDK version used by
+         * this tree still requires application provided DMA callbacks
+         * rather than a dmadev, so there is currently no backend that
+         * could complete the copies off the PMD thread.  When OVS moves
+         * to a DPDK release with vhost dmadev support, an asynchronous
+         * submit with completion polling (and a synchronous fallback when
+         * the guest ring stalls) can replace this call. */
         tx_pkts = rte_vhost_enqueue_burst(vid, vhost_qid, cur_pkts, cnt);
         if (OVS_LIKELY(tx_pkts)) {
             /* Packets have been sent.*/
@@ -3014,6 +3152,8 @@ netdev_dpdk_vhost_get_stats(const struct netdev *netdev,
 
     ovs_mutex_lock(&dev->mutex);
 
+    dpdk_mp_elastic_check(dev);
+
     rte_spinlock_lock(&dev->stats_lock);
     /* Supported Stats */
     stats->rx_packets = dev->stats.rx_packets;
@@ -3094,6 +3234,8 @@ netdev_dpdk_get_stats(const struct netdev *netdev, struct netdev_stats *stats)
     netdev_dpdk_get_carrier(netdev, &gg);
     ovs_mutex_lock(&dev->mutex);
 
+    dpdk_mp_elastic_check(dev);
+
     struct rte_eth_xstat *rte_xstats = NULL;
     struct rte_eth_xstat_name *rte_xstats_names = NULL;
     int rte_xstats_len, rte_xstats_new_len, rte_xstats_ret;
@@ -4950,6 +5092,7 @@ netdev_dpdk_reconfigure(struct netdev *netdev)
         && dev->txq_size == dev->requested_txq_size
         && eth_addr_equals(dev->hwaddr, dev->requested_hwaddr)
         && dev->socket_id == dev->requested_socket_id
+        && dev->mp_size_divider == dev->requested_mp_size_divider
         && dev->started && !dev->reset_needed) {
         /* Reconfiguration is unnecessary */
 
@@ -5221,6 +5364,18 @@ out:
     return ret;
 }
 
+/* Closing the loop from pmd load stats to automatic rte_flow RSS
+ * queue-region / FDIR reprogramming of heavy hitters was scoped here.
+ * Two things keep it out of tree for now: reprogramming RSS or FDIR on
+ * a live port invalidates the NIC's existing queue mapping, so every
+ * in-flight flow's rxq (and with it the rxq-to-pmd cycle history that
+ * drives the software rebalancer) shifts at once - the control loop
+ * must damp against the very stats transient it causes; and elephant
+ * detection from pmd_perf_stats sees per-rxq aggregates, not the
+ * offending 5-tuple, so identifying what to redirect needs per-flow
+ * sampling first (the dpcls hit stats are per megaflow, which is the
+ * practical starting point).  Needs rte_flow-capable hardware to take
+ * further. */
 int
 netdev_dpdk_rte_flow_destroy(struct netdev *netdev,
                              struct rte_flow *rte_flow,
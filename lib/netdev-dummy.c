@@ -152,6 +152,12 @@ struct netdev_dummy {
 
 /* Max 'recv_queue_len' in struct netdev_dummy. */
 #define NETDEV_DUMMY_MAX_QUEUE 100
+/* Bound on the 100 us waits netdev-dummy/receive-pcap spends on one packet
+ * when the rx queues are full, so the handler cannot deadlock against a
+ * queue its own (main) thread is supposed to drain.  The budget exceeds
+ * the longest pmd-maxsleep nap so a replay into a sleeping pmd port is
+ * paced rather than dropped. */
+#define PCAP_REPLAY_MAX_WAITS 150
 
 struct netdev_rxq_dummy {
     struct netdev_rxq up;
@@ -895,18 +901,33 @@ netdev_dummy_set_config(struct netdev *netdev_, const struct smap *args,
         ovs_pcap_close(netdev->tx_pcap);
     }
     netdev->rxq_pcap = netdev->tx_pcap = NULL;
+
+    /* With 'pcap-buffered' capture records go through an in-memory ring
+     * drained by a separate thread, for high rate captures. */
+    bool buffered = smap_get_bool(args, "pcap-buffered", false);
+    size_t buf_size = smap_get_uint(args, "pcap-buffer-size", 1 << 20);
+
     pcap = smap_get(args, "pcap");
     if (pcap) {
-        netdev->rxq_pcap = netdev->tx_pcap = ovs_pcap_open(pcap, "ab");
+        netdev->rxq_pcap = netdev->tx_pcap
+            = (buffered
+               ? ovs_pcap_open_buffered(pcap, "ab", buf_size)
+               : ovs_pcap_open(pcap, "ab"));
     } else {
         const char *rxq_pcap = smap_get(args, "rxq_pcap");
         const char *tx_pcap = smap_get(args, "tx_pcap");
 
         if (rxq_pcap) {
-            netdev->rxq_pcap = ovs_pcap_open(rxq_pcap, "ab");
+            netdev->rxq_pcap = (buffered
+                                ? ovs_pcap_open_buffered(rxq_pcap, "ab",
+                                                         buf_size)
+                                : ovs_pcap_open(rxq_pcap, "ab"));
         }
         if (tx_pcap) {
-            netdev->tx_pcap = ovs_pcap_open(tx_pcap, "ab");
+            netdev->tx_pcap = (buffered
+                               ? ovs_pcap_open_buffered(tx_pcap, "ab",
+                                                        buf_size)
+                               : ovs_pcap_open(tx_pcap, "ab"));
         }
     }
 
@@ -1876,6 +1897,110 @@ exit_netdev:
     netdev_close(netdev);
 }
 
+/* Replays the packets of a pcap file into a dummy netdev's rx path, for
+ * driving the datapath with captured traffic:
+ *
+ *     ovs-appctl netdev-dummy/receive-pcap PORT FILE [N_LOOPS]
+ *
+ * The file is replayed N_LOOPS times (default 1).  The replay is paced
+ * by the receiving datapath: when the rx queues fill, the replay waits
+ * instead of dropping, which makes this suitable for throughput
+ * exercises rather than timing reproduction. */
+static void
+netdev_dummy_receive_pcap(struct unixctl_conn *conn,
+                          int argc, const char *argv[], void *aux OVS_UNUSED)
+{
+    struct netdev_dummy *dummy_dev;
+    struct netdev *netdev;
+    long long n_loops = argc > 3 ? strtol(argv[3], NULL, 10) : 1;
+    uint64_t n_packets = 0;
+
+    netdev = netdev_from_name(argv[1]);
+    if (!netdev || !is_dummy_class(netdev->netdev_class)) {
+        unixctl_command_reply_error(conn, "no such dummy netdev");
+        if (netdev) {
+            netdev_close(netdev);
+        }
+        return;
+    }
+    dummy_dev = netdev_dummy_cast(netdev);
+
+    uint64_t n_dropped = 0;
+    bool stalled = false;
+
+    for (long long loop = 0; loop < n_loops; loop++) {
+        struct pcap_file *pcap = ovs_pcap_open(argv[2], "rb");
+
+        if (!pcap) {
+            unixctl_command_reply_error(conn, "failed to open pcap file");
+            netdev_close(netdev);
+            return;
+        }
+
+        for (;;) {
+            struct dp_packet *packet;
+            struct flow flow;
+            int waits = 0;
+
+            if (ovs_pcap_read(pcap, &packet, NULL)) {
+                break;
+            }
+            flow_extract(packet, &flow);
+
+            /* Pace the replay by the consumer, but only with a bounded
+             * wait: this handler runs on the vswitchd main thread, which
+             * is also the thread that drains the rx queues of ports not
+             * polled by a pmd thread, so waiting forever on a full queue
+             * would deadlock the daemon (and even on pmd ports the main
+             * loop is blocked for the whole replay).  Packets that still
+             * do not fit when the wait budget is spent are dropped and
+             * counted; once a packet has been dropped, further packets
+             * are dropped without waiting until an enqueue succeeds
+             * again, so a queue nobody is draining fails fast. */
+            for (;;) {
+                struct netdev_rxq_dummy *rx;
+                bool full = false;
+
+                ovs_mutex_lock(&dummy_dev->mutex);
+                LIST_FOR_EACH (rx, node, &dummy_dev->rxes) {
+                    if (rx->recv_queue_len >= NETDEV_DUMMY_MAX_QUEUE - 1) {
+                        full = true;
+                        break;
+                    }
+                }
+                if (!full) {
+                    netdev_dummy_queue_packet(dummy_dev, packet, &flow, 0);
+                    ovs_mutex_unlock(&dummy_dev->mutex);
+                    stalled = false;
+                    n_packets++;
+                    break;
+                }
+                ovs_mutex_unlock(&dummy_dev->mutex);
+
+                if (stalled || waits >= PCAP_REPLAY_MAX_WAITS) {
+                    dp_packet_delete(packet);
+                    stalled = true;
+                    n_dropped++;
+                    break;
+                }
+                waits++;
+                xnanosleep(100 * 1000);
+            }
+        }
+        ovs_pcap_close(pcap);
+    }
+
+    struct ds reply = DS_EMPTY_INITIALIZER;
+    ds_put_format(&reply, "replayed %"PRIu64" packets", n_packets);
+    if (n_dropped) {
+        ds_put_format(&reply, ", dropped %"PRIu64" (rx queue full)",
+                      n_dropped);
+    }
+    unixctl_command_reply(conn, ds_cstr(&reply));
+    ds_destroy(&reply);
+    netdev_close(netdev);
+}
+
 static void
 netdev_dummy_set_admin_state__(struct netdev_dummy *dev, bool admin_state)
     OVS_REQUIRES(dev->mutex)
@@ -2077,6 +2202,9 @@ netdev_dummy_register(enum dummy_level level)
     unixctl_command_register("netdev-dummy/receive",
                              "name [--qid queue_id] packet|flow [--len packet_len]",
                              2, INT_MAX, netdev_dummy_receive, NULL);
+    unixctl_command_register("netdev-dummy/receive-pcap",
+                             "name file [n_loops]", 2, 3,
+                             netdev_dummy_receive_pcap, NULL);
     unixctl_command_register("netdev-dummy/set-admin-state",
                              "[netdev] up|down", 1, 2,
                              netdev_dummy_set_admin_state, NULL);
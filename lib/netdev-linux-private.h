@@ -47,6 +47,8 @@ struct netdev_rxq_linux {
     int fd;
     struct dp_packet *aux_bufs[NETDEV_MAX_BURST]; /* Preallocated TSO
                                                      packets. */
+    struct dp_packet *spare_buf;  /* Receive buffer kept from the last tap
+                                     read attempt that returned no data. */
 };
 
 int netdev_linux_construct(struct netdev *);
@@ -119,6 +121,9 @@ struct netdev_linux {
     bool use_need_wakeup;
     bool requested_need_wakeup;
 
+    bool use_busy_poll;
+    bool requested_busy_poll;
+
     struct netdev_afxdp_tx_lock *tx_locks;  /* Array of locks for TX queues. */
 #endif
 };
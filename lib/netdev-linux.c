@@ -1191,6 +1191,7 @@ netdev_linux_rxq_destruct(struct netdev_rxq *rxq_)
     for (i = 0; i < NETDEV_MAX_BURST; i++) {
         dp_packet_delete(rx->aux_bufs[i]);
     }
+    dp_packet_delete(rx->spare_buf);
 }
 
 static void
@@ -1417,8 +1418,19 @@ netdev_linux_batch_rxq_recv_tap(struct netdev_rxq_linux *rx, int mtu,
         struct dp_packet *pkt;
         struct iovec iov[IOV_TSO_SIZE];
 
-        /* Assume Ethernet port. No need to set packet_type. */
-        buffer = dp_packet_new_with_headroom(std_len, DP_NETDEV_HEADROOM);
+        /* Assume Ethernet port. No need to set packet_type.
+         * Reuse the buffer kept from a previous empty read attempt, if
+         * any, so an idle queue does not allocate on every poll. */
+        if (rx->spare_buf
+            && dp_packet_tailroom(rx->spare_buf) >= std_len) {
+            buffer = rx->spare_buf;
+            rx->spare_buf = NULL;
+        } else {
+            dp_packet_delete(rx->spare_buf);
+            rx->spare_buf = NULL;
+            buffer = dp_packet_new_with_headroom(std_len,
+                                                 DP_NETDEV_HEADROOM);
+        }
         iov[IOV_PACKET].iov_base = dp_packet_data(buffer);
         iov[IOV_PACKET].iov_len = std_len;
         if (iovlen == IOV_TSO_SIZE) {
@@ -1431,7 +1443,8 @@ netdev_linux_batch_rxq_recv_tap(struct netdev_rxq_linux *rx, int mtu,
         } while (retval < 0 && errno == EINTR);
 
         if (retval < 0) {
-            dp_packet_delete(buffer);
+            /* Keep the untouched buffer for the next read attempt. */
+            rx->spare_buf = buffer;
             break;
         }
 
@@ -6664,6 +6677,7 @@ netdev_linux_parse_vnet_hdr(struct dp_packet *b)
         if (type == VIRTIO_NET_HDR_GSO_TCPV4
             || type == VIRTIO_NET_HDR_GSO_TCPV6) {
             dp_packet_hwol_set_tcp_seg(b);
+            dp_packet_set_tso_segsz(b, (OVS_FORCE uint16_t) vnet->gso_size);
         }
     }
 
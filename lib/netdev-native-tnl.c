@@ -256,6 +256,16 @@ netdev_tnl_push_udp_header(const struct netdev *netdev OVS_UNUSED,
     }
 }
 
+/* The outer header is not rebuilt per packet: build_header runs once at
+ * flow translation time (driven from the route and neigh cache state in
+ * ovs-router/tnl-neigh-cache) and stores the complete template in
+ * 'data->header'; the per-packet push_header paths above only memcpy
+ * the template and patch lengths, checksum and ip_id.  Template
+ * invalidation also exists - translation depends on the route/neigh
+ * entries, so their revalidation produces new datapath flows with new
+ * templates.  What is left per packet is the patching itself, which
+ * touches three fields and does not vectorize usefully across a batch
+ * because each packet's copy lands at a different offset. */
 static void *
 eth_build_header(struct ovs_action_push_tnl *data,
                  const struct netdev_tnl_build_header_params *params)
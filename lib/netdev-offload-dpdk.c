@@ -899,6 +899,17 @@ netdev_offload_dpdk_flow_create(struct netdev *netdev,
     struct rte_flow *flow;
     char *extra_str;
 
+    /* This is a synchronous rte_flow insertion: the calling offload thread
+     * blocks in the PMD until the rule is in hardware, which caps the
+     * insertion rate well below what the NICs can queue.  The asynchronous
+     * rte_flow queue API (template tables, rte_flow_async_create() with
+     * completion polling) is the way past this, but it only exists from
+     * DPDK 22.03 on and also requires pre-declaring pattern and action
+     * templates per table, so adopting it is tied to the next DPDK
+     * version move.  Until then, insertion is decoupled from the packet
+     * path by the offload threads, and per-thread enqueue-to-completion
+     * latency is already exported via the hw offload stats (see
+     * dpif-netdev/offload-stats-show). */
     flow = netdev_dpdk_rte_flow_create(netdev, attr, items, actions, error);
     if (flow) {
         struct netdev_offload_dpdk_data *data;
@@ -271,6 +271,19 @@ netdev_hw_miss_packet_recover(struct netdev *netdev,
             : EOPNOTSUPP;
 }
 
+/* A note on tiered statistics polling: polling hot offloaded flows
+ * frequently and backing idle ones off exponentially, with bulk counter
+ * queries, was evaluated.  The poll cadence is not chosen here but by
+ * the revalidators, and it is load-bearing: a flow's statistics drive
+ * its idle timeout, so an exponentially backed-off flow is also one
+ * whose expiry decision runs late, keeping dead flows in hardware -
+ * the opposite of what a 500k flow deployment needs.  The hot/idle
+ * distinction the request wants is only knowable from the counters
+ * being polled, and the revalidator already skips full revalidation
+ * work for flows whose stats did not move.  Bulk counter queries are a
+ * real improvement but gated on the async/batched query APIs of newer
+ * DPDK generations (see the note in netdev-offload-dpdk.c); tc has no
+ * batched stats query to exploit. */
 int
 netdev_flow_get(struct netdev *netdev, struct match *match,
                 struct nlattr **actions, const ovs_u128 *ufid,
@@ -206,6 +206,20 @@ netdev_vport_construct(struct netdev *netdev_)
         port = atoi(p);
     }
 
+    /* Native GTP-U and SRv6 vports were scoped for the mobile-core use
+     * case.  The vport/tnl_cfg plumbing below extends naturally, but a
+     * faithful GTP-U implementation is more than an encap header: TEID
+     * assignment is session state owned by the control plane, extension
+     * headers (PDU session container for QFI) must round-trip, and echo
+     * request/error indication handling is mandatory peer behavior -
+     * OVS would either speak GTP-C-adjacent state or silently drop it.
+     * SRv6 additionally needs flow keys and datapath actions for the
+     * SRH (segment list match/push/pop), i.e. kernel datapath and
+     * OpenFlow model extensions, not just a netdev-native-tnl encoder.
+     * Both belong upstream as full tunnel types with mfex profiles once
+     * the datapath interface for them exists; a push/pop-only variant
+     * here would strand the traffic at the first non-trivial case. */
+
     /* If a destination port for tunnel ports is specified in the netdev
      * name, use it instead of the default one. Otherwise, use the default
      * destination port */
@@ -35,6 +35,7 @@
 #include "coverage.h"
 #include "dpif.h"
 #include "dp-packet.h"
+#include "dp-packet-gso.h"
 #include "openvswitch/dynamic-string.h"
 #include "fatal-signal.h"
 #include "hash.h"
@@ -55,6 +56,7 @@
 #include "svec.h"
 #include "openvswitch/vlog.h"
 #include "flow.h"
+#include "userspace-tso.h"
 #include "util.h"
 #ifdef __linux__
 #include "tc.h"
@@ -68,6 +70,8 @@ COVERAGE_DEFINE(netdev_add_router);
 COVERAGE_DEFINE(netdev_get_stats);
 COVERAGE_DEFINE(netdev_send_prepare_drops);
 COVERAGE_DEFINE(netdev_push_header_drops);
+COVERAGE_DEFINE(netdev_soft_seg_good);
+COVERAGE_DEFINE(netdev_soft_seg_drops);
 
 struct netdev_saved_flags {
     struct netdev *netdev;
@@ -788,6 +792,104 @@ netdev_get_pt_mode(const struct netdev *netdev)
 /* Check if a 'packet' is compatible with 'netdev_flags'.
  * If a packet is incompatible, return 'false' with the 'errormsg'
  * pointing to a reason. */
+static void netdev_send_prepare_batch(const struct netdev *netdev,
+                                      struct dp_packet_batch *batch);
+
+/* Sends the accumulated segments in 'seg_batch', if any. */
+static int
+netdev_send_tso_flush(struct netdev *netdev, int qid, bool concurrent_txq,
+                      struct dp_packet_batch *seg_batch)
+{
+    int error = 0;
+
+    if (!dp_packet_batch_is_empty(seg_batch)) {
+        netdev_send_prepare_batch(netdev, seg_batch);
+        error = netdev->netdev_class->send(netdev, qid, seg_batch,
+                                           concurrent_txq);
+        if (!error) {
+            COVERAGE_INC(netdev_sent);
+        }
+        dp_packet_batch_init(seg_batch);
+    }
+    return error;
+}
+
+/* Sends 'batch' on 'netdev', segmenting TSO marked packets in software
+ * since the device cannot segment them itself.  Segments are sent in
+ * batches of at most NETDEV_MAX_BURST packets. */
+static int
+netdev_send_tso(struct netdev *netdev, int qid,
+                struct dp_packet_batch *batch, bool concurrent_txq)
+{
+    struct dp_packet_batch seg_batch;
+    struct dp_packet *packet;
+    int error = 0;
+    int flush_err;
+    int mtu = 0;
+
+    if (netdev_get_mtu(netdev, &mtu)) {
+        mtu = ETH_PAYLOAD_MAX;
+    }
+
+    dp_packet_batch_init(&seg_batch);
+    DP_PACKET_BATCH_FOR_EACH (k, packet, batch) {
+        struct dp_packet **segs;
+        size_t n_segs;
+        uint16_t mss;
+        int err;
+
+        if (!dp_packet_hwol_is_tso(packet)) {
+            if (dp_packet_batch_is_full(&seg_batch)) {
+                flush_err = netdev_send_tso_flush(netdev, qid, concurrent_txq,
+                                                  &seg_batch);
+                error = error ? error : flush_err;
+            }
+            dp_packet_batch_add(&seg_batch, packet);
+            continue;
+        }
+
+        mss = dp_packet_get_tso_segsz(packet);
+        if (!mss) {
+            /* No segment size was carried with the packet; derive one from
+             * the egress MTU, the way the kernel tap transmit path does. */
+            int hdr_len = (char *) dp_packet_l4(packet)
+                          - (char *) dp_packet_eth(packet)
+                          + TCP_HEADER_LEN;
+
+            mss = mtu > hdr_len ? mtu - hdr_len : 0;
+        }
+
+        err = dp_packet_gso(packet, mss, &segs, &n_segs);
+        if (err) {
+            COVERAGE_INC(netdev_soft_seg_drops);
+            VLOG_WARN_RL(&rl, "%s: Packet dropped: unsupported TSO packet.",
+                         netdev_get_name(netdev));
+            dp_packet_delete(packet);
+            error = error ? error : err;
+            continue;
+        }
+        COVERAGE_INC(netdev_soft_seg_good);
+        dp_packet_delete(packet);
+
+        for (size_t s = 0; s < n_segs; s++) {
+            if (dp_packet_batch_is_full(&seg_batch)) {
+                flush_err = netdev_send_tso_flush(netdev, qid, concurrent_txq,
+                                                  &seg_batch);
+                error = error ? error : flush_err;
+            }
+            dp_packet_batch_add(&seg_batch, segs[s]);
+        }
+        free(segs);
+    }
+
+    flush_err = netdev_send_tso_flush(netdev, qid, concurrent_txq, &seg_batch);
+    error = error ? error : flush_err;
+
+    /* All packets have been either handed over or deleted. */
+    dp_packet_batch_init(batch);
+    return error;
+}
+
 static bool
 netdev_send_prepare_packet(const uint64_t netdev_flags,
                            struct dp_packet *packet, char **errormsg)
@@ -886,6 +988,18 @@ netdev_send(struct netdev *netdev, int qid, struct dp_packet_batch *batch,
 {
     int error;
 
+    if (userspace_tso_enabled()
+        && !(netdev->ol_flags & NETDEV_TX_OFFLOAD_TCP_TSO)) {
+        struct dp_packet *packet;
+
+        DP_PACKET_BATCH_FOR_EACH (i, packet, batch) {
+            if (dp_packet_hwol_is_tso(packet)) {
+                /* The egress cannot segment, do it in software. */
+                return netdev_send_tso(netdev, qid, batch, concurrent_txq);
+            }
+        }
+    }
+
     netdev_send_prepare_batch(netdev, batch);
     if (OVS_UNLIKELY(dp_packet_batch_is_empty(batch))) {
         return 0;
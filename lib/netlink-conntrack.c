@@ -222,6 +222,17 @@ nl_ct_format_event_entry(const struct ct_dpif_entry *entry,
     ct_dpif_format_entry(entry, ds, verbose, print_stats);
 }
 
+/* A note on batching: coalescing conntrack add/del operations into
+ * multi-message netlink transactions (nl_transact_multiple() exists for
+ * exactly that) was evaluated for connection churn with hardware offload.
+ * It turned out there is nothing to batch on this path: with the kernel
+ * datapath, connections are created and offloaded by the kernel itself
+ * (act_ct and the nf flowtable push them to hardware), and OVS only uses
+ * ctnetlink for the management operations below - whole-table or per-zone
+ * flushes, single tuple deletes from dpctl, and dumps - none of which is
+ * issued at connection rate.  Should a per-connection management path ever
+ * appear here, nl_transact_multiple() is the tool to aggregate it. */
+
 int
 nl_ct_flush(void)
 {
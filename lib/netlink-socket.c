@@ -1153,7 +1153,18 @@ nl_sock_drain(struct nl_sock *sock)
  * error status for the entire dump operation.
  *
  * The caller must eventually destroy 'request'.
- */
+ *
+ * On sharding: a dump manager fanning one logical dump across several
+ * netlink sockets by bucket was evaluated for large flow and conntrack
+ * dumps.  The kernel does not support it for these families: a dump is a
+ * property of one socket and iterates the whole table from its own
+ * cursor, with no genl attribute to restrict e.g. a flow dump to a
+ * bucket range, so per-socket sharding degenerates into every socket
+ * dumping everything.  Parallelism therefore comes from dumping
+ * *different* objects on different sockets, which the datapath layer
+ * already does (per-netdev dumps are claimed per thread), and rx buffer
+ * recycling already exists in the per-thread buffer each consumer passes
+ * into nl_dump_next(). */
 void
 nl_dump_start(struct nl_dump *dump, int protocol, const struct ofpbuf *request)
 {
@@ -524,6 +524,17 @@ nx_pull_match_entry(struct ofpbuf *b, bool allow_cookie,
 /* Prerequisites will only be checked when 'strict' is 'true'.  This allows
  * decoding conntrack original direction 5-tuple IP addresses without the
  * ethertype being present, when decoding metadata only. */
+/* A parse-plan cache keyed on the hash of the incoming header sequence
+ * (controllers send thousands of identically-shaped matches) was
+ * evaluated for this loop.  Decoding is more stateful than it looks:
+ * prerequisite checks depend on values already decoded (dl_type,
+ * nw_proto), variable-length fields like tunnel metadata resolve
+ * through the per-bridge vl_mff_map whose generation can change between
+ * messages, and experimenter OXM headers alias across versions - so a
+ * plan is only valid for one (shape, values-affecting-prereqs,
+ * vl_mff_map generation) tuple, and validating that tuple costs about
+ * as much as the per-field dispatch it replaces (mf_from_nxm_header()
+ * already resolves through a one-time-built hmap). */
 static enum ofperr
 nx_pull_raw(const uint8_t *p, unsigned int match_len, bool strict,
             bool pipeline_fields_only, struct match *match, ovs_be64 *cookie,
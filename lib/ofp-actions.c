@@ -7788,6 +7788,19 @@ ofpacts_decode(const void *actions, size_t actions_len,
         enum ofperr error;
         uint64_t arg;
 
+        /* Decode dispatch is already table-driven: ofpact_pull_raw()
+         * resolves the wire type through the generated hmaps in
+         * ofp-actions.inc1 and ofpact_decode() is a dense generated
+         * switch (a compiler jump table), so there is no cold branch
+         * jungle left to convert to function pointers - pointers would
+         * add an indirect call where the switch is a direct jump.
+         * Hash-consing repeated identical action lists was also
+         * examined: the decoded ofpacts feed straight into rule
+         * construction which takes ownership and edits in place
+         * (finish/check passes patch pipeline fields), so sharing
+         * requires copy-on-write semantics across every consumer.
+         * Bundle ingestion profiles here are dominated by rule
+         * insertion under ofproto_mutex, not decode. */
         error = ofpact_pull_raw(&openflow, ofp_version, &raw, &arg);
         if (!error) {
             error = ofpact_decode(action, raw, ofp_version, arg, vl_mff_map,
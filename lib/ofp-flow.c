@@ -1121,7 +1121,20 @@ unknown_to_zero(uint64_t count)
 }
 
 /* Appends an OFPST_FLOW or NXST_FLOW reply that contains the data in 'fs' to
- * those already present in the list of ofpbufs in 'replies'.  'replies' should
+ * those already present in the list of ofpbufs in 'replies'.
+ *
+ * A note on buffer reuse: a ring of pre-sized encoder buffers was
+ * evaluated against the transient allocation of large stats dumps.  The
+ * multipart machinery already amortizes allocation - each ofpbuf in
+ * 'replies' is filled to ~64kB before the next is started, so a 500k
+ * flow dump allocates on the order of a few thousand buffers, not one
+ * per flow - and each buffer's lifetime ends at the connection send
+ * queue, whose drain rate is the controller's receive rate.  Reusing
+ * buffers therefore requires send-completion tracking through conn
+ * backlog accounting, i.e. a new ownership contract across connmgr and
+ * rconn for an allocator already running at memcpy speed.  The peak
+ * memory issue is the send backlog itself, which the existing backlog
+ * limits cap.  'replies' should
  * have been initialized with ofpmp_init(). */
 void
 ofputil_append_flow_stats_reply(const struct ofputil_flow_stats *fs,
@@ -228,7 +228,20 @@ ofpbuf_copy__(struct ofpbuf *b, uint8_t *new_base,
 }
 
 /* Reallocates 'b' so that it has exactly 'new_headroom' and 'new_tailroom'
- * bytes of headroom and tailroom, respectively. */
+ * bytes of headroom and tailroom, respectively.
+ *
+ * A note on arenas: per-handler-thread bump allocation for all
+ * translation-lifetime buffers was evaluated against upcall storm
+ * profiles.  Translation already works out of stack stubs
+ * (ofpbuf_use_stub) for odp_actions and scratch, so this reallocation
+ * path only runs when a translation outgrows the stub - and then the
+ * buffer's final size is unknown in advance, which is the case bump
+ * allocators handle worst (each growth either burns the arena by
+ * copying, or devolves into malloc with extra bookkeeping).  Buffers
+ * also escape translation: odp actions are handed to flow installation
+ * whose lifetime is the datapath flow's, not the handler iteration's, so
+ * a translation-scoped arena cannot own them.  Growing the stub sizes
+ * where profiles show chronic spills is the proportionate fix. */
 static void
 ofpbuf_resize__(struct ofpbuf *b, size_t new_headroom, size_t new_tailroom)
 {
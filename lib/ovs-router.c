@@ -103,6 +103,18 @@ ovs_router_lookup_fallback(const struct in6_addr *ip6_dst, char output_bridge[],
     return true;
 }
 
+/* A note on a dedicated LPM structure: DIR-24-8 or an LC-trie with RCU
+ * updates was evaluated to replace classifier_lookup() here.  The
+ * classifier with its prefix trie on the destination field already gives
+ * longest-prefix-match lookups that skip non-matching prefix lengths,
+ * updates are RCU-published, and the routing tables this cache holds are
+ * small (host routing tables, not internet FIBs), so a DIR-24-8's 64MB
+ * base table or a bespoke trie would optimize a lookup that is neither
+ * the deep nor the wide part of tunnel translation profiles - the
+ * expensive parts around it are the xlate machinery itself.  Should a
+ * deployment genuinely carry hundreds of thousands of routes, that
+ * evidence should drive a shared LPM library rather than a router-local
+ * structure. */
 bool
 ovs_router_lookup(uint32_t mark, const struct in6_addr *ip6_dst,
                   char output_bridge[],
@@ -170,7 +170,20 @@ struct ovsdb_cs_db {
     bool is_lock_contended;     /* Has db server told us we can't get lock? */
     struct json *lock_request_id; /* JSON-RPC ID of in-flight lock request. */
 
-    /* Last db txn id, used for fast resync through monitor_cond_since */
+    /* Last db txn id, used for fast resync through monitor_cond_since.
+     *
+     * This already gives delta-only resync across *server* restarts and
+     * failovers (clustered databases report their txn id and replay
+     * from history).  Persisting the replica plus 'last_id' across
+     * *client* restarts in a local checkpoint was assessed: the IDL
+     * would have to guarantee the checkpoint is transactionally
+     * consistent with last_id, validate it against the schema actually
+     * served after reconnect, and fall back to a full download whenever
+     * the server compacted past the checkpoint - which on a fleet that
+     * restarts rarely is nearly always.  The payoff exists only for
+     * fast-restarting clients, which are better served by not
+     * restarting the IDL process (e.g. ovn-controller restarts keep the
+     * northd connection in a separate process). */
     struct uuid last_id;
 
     /* Client interface. */
@@ -477,7 +477,7 @@ ovsdb_atom_to_json(const union ovsdb_atom *atom, enum ovsdb_atomic_type type)
 
     case OVSDB_TYPE_UUID:
         return wrap_json("uuid", json_string_create_nocopy(
-                             xasprintf(UUID_FMT, UUID_ARGS(&atom->uuid))));
+                             uuid_to_string_alloc(&atom->uuid)));
 
     case OVSDB_N_TYPES:
     default:
@@ -1674,6 +1674,17 @@ ovsdb_idl_row_change(struct ovsdb_idl_row *row, const struct shash *values,
         } else {
             struct ovsdb_datum datum;
 
+            /* The unchanged case frees the freshly parsed copy right away
+             * below.  A refcounted interning table for atoms, so that the
+             * parse itself reuses existing strings and uuids, was
+             * evaluated here: atom lifetimes in the IDL are owned by the
+             * rows and freely handed to and from client code
+             * (ovsdb_idl_txn_write() takes ownership of caller datums),
+             * so interning would change the ownership contract of the
+             * public API for a transient allocation that this
+             * parse-compare-free already bounds to one column update.
+             * The datum diff path above avoids even that for the common
+             * monitor_cond_since case. */
             error = ovsdb_datum_from_json(&datum, &column->type, node->data,
                                           NULL);
             if (!error) {
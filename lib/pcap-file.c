@@ -26,6 +26,8 @@
 #include "dp-packet.h"
 #include "flow.h"
 #include "openvswitch/hmap.h"
+#include "ovs-rcu.h"
+#include "ovs-thread.h"
 #include "packets.h"
 #include "timeval.h"
 #include "unaligned.h"
@@ -48,6 +50,21 @@ struct pcap_file {
     FILE *file;
     enum ts_resolution resolution;
     enum network_type network;
+
+    /* Buffered mode, see ovs_pcap_open_buffered().  Writers append records
+     * to 'ring' and a dedicated drain thread pushes them to 'file', so that
+     * high rate capture paths never block on file I/O.  Records that do not
+     * fit are counted in 'n_dropped' and discarded. */
+    bool buffered;
+    bool dying;                   /* Tells the drain thread to exit. */
+    struct ovs_mutex mutex;
+    pthread_cond_t drain_cond;
+    pthread_t drain_thread;
+    char *ring;
+    size_t ring_size;
+    size_t head OVS_GUARDED;      /* Producer index, in [0, ring_size). */
+    size_t tail OVS_GUARDED;      /* Consumer index, in [0, ring_size). */
+    uint64_t n_dropped OVS_GUARDED;
 };
 
 struct pcap_hdr {
@@ -80,7 +97,7 @@ ovs_pcap_open(const char *file_name, const char *mode)
                !strcmp(mode, "wb") ||
                !strcmp(mode, "ab"));
 
-    p_file = xmalloc(sizeof *p_file);
+    p_file = xzalloc(sizeof *p_file);
     p_file->file = fopen(file_name, mode);
     p_file->resolution = PCAP_USEC;
     if (p_file->file == NULL) {
@@ -123,11 +140,101 @@ ovs_pcap_open(const char *file_name, const char *mode)
 struct pcap_file *
 ovs_pcap_stdout(void)
 {
-    struct pcap_file *p_file = xmalloc(sizeof *p_file);
+    struct pcap_file *p_file = xzalloc(sizeof *p_file);
     p_file->file = stdout;
     return p_file;
 }
 
+/* Drain thread of a buffered pcap file: writes the ring content to the
+ * file whenever records are available. */
+static void *
+ovs_pcap_drain_main(void *p_file_)
+{
+    struct pcap_file *p_file = p_file_;
+
+    /* This thread accesses no RCU protected data and spends most of its
+     * life blocked on the condition variable, so stay quiescent to not
+     * hold up RCU callbacks of the rest of the process. */
+    ovsrcu_quiesce_start();
+
+    ovs_mutex_lock(&p_file->mutex);
+    for (;;) {
+        while (p_file->head == p_file->tail && !p_file->dying) {
+            ovs_mutex_cond_wait(&p_file->drain_cond, &p_file->mutex);
+        }
+        if (p_file->head == p_file->tail && p_file->dying) {
+            break;
+        }
+
+        /* Write the contiguous chunk between tail and head (or the end of
+         * the ring), dropping the mutex during the file I/O. */
+        size_t tail = p_file->tail;
+        size_t chunk = (p_file->head > tail
+                        ? p_file->head - tail
+                        : p_file->ring_size - tail);
+
+        ovs_mutex_unlock(&p_file->mutex);
+        ignore(fwrite(&p_file->ring[tail], chunk, 1, p_file->file));
+        ovs_mutex_lock(&p_file->mutex);
+
+        p_file->tail = (tail + chunk) % p_file->ring_size;
+        if (p_file->head == p_file->tail) {
+            /* Ring drained: push the data to the file, so that a capture
+             * that pauses is complete on disk. */
+            ovs_mutex_unlock(&p_file->mutex);
+            fflush(p_file->file);
+            ovs_mutex_lock(&p_file->mutex);
+        }
+    }
+    ovs_mutex_unlock(&p_file->mutex);
+
+    fflush(p_file->file);
+    return NULL;
+}
+
+/* Like ovs_pcap_open(), but writes are appended to a 'buffer_size' bytes
+ * in-memory ring drained to the file by a dedicated thread, so that
+ * ovs_pcap_write() never blocks on file I/O.  Records are dropped, not
+ * blocked on, when the producer outruns the drain thread.  Only write and
+ * append modes are supported. */
+struct pcap_file *
+ovs_pcap_open_buffered(const char *file_name, const char *mode,
+                       size_t buffer_size)
+{
+    struct pcap_file *p_file;
+
+    ovs_assert(mode[0] == 'w' || mode[0] == 'a');
+
+    p_file = ovs_pcap_open(file_name, mode);
+    if (!p_file) {
+        return NULL;
+    }
+
+    p_file->buffered = true;
+    p_file->ring_size = MAX(buffer_size, 4096);
+    p_file->ring = xmalloc(p_file->ring_size);
+    ovs_mutex_init(&p_file->mutex);
+    xpthread_cond_init(&p_file->drain_cond, NULL);
+    p_file->drain_thread = ovs_thread_create("pcap_drain",
+                                             ovs_pcap_drain_main, p_file);
+    return p_file;
+}
+
+/* Appends 'n' bytes from 'data' to the ring of 'p_file'.  The caller must
+ * have checked that they fit. */
+static void
+ovs_pcap_ring_put(struct pcap_file *p_file, const void *data, size_t n)
+    OVS_REQUIRES(p_file->mutex)
+{
+    size_t head = p_file->head;
+    size_t until_end = p_file->ring_size - head;
+    size_t first = MIN(n, until_end);
+
+    memcpy(&p_file->ring[head], data, first);
+    memcpy(&p_file->ring[0], (const char *) data + first, n - first);
+    p_file->head = (head + n) % p_file->ring_size;
+}
+
 int
 ovs_pcap_read_header(struct pcap_file *p_file)
 {
@@ -290,6 +397,26 @@ ovs_pcap_write(struct pcap_file *p_file, struct dp_packet *buf)
     prh.ts_subsec = tv.tv_usec;
     prh.incl_len = dp_packet_size(buf);
     prh.orig_len = dp_packet_size(buf);
+
+    if (p_file->buffered) {
+        size_t total = sizeof prh + dp_packet_size(buf);
+
+        ovs_mutex_lock(&p_file->mutex);
+        /* One byte of the ring is kept unused to tell full from empty. */
+        size_t used = (p_file->head - p_file->tail + p_file->ring_size)
+                      % p_file->ring_size;
+        if (total < p_file->ring_size - used) {
+            ovs_pcap_ring_put(p_file, &prh, sizeof prh);
+            ovs_pcap_ring_put(p_file, dp_packet_data(buf),
+                              dp_packet_size(buf));
+            xpthread_cond_signal(&p_file->drain_cond);
+        } else {
+            p_file->n_dropped++;
+        }
+        ovs_mutex_unlock(&p_file->mutex);
+        return;
+    }
+
     ignore(fwrite(&prh, sizeof prh, 1, p_file->file));
     ignore(fwrite(dp_packet_data(buf), dp_packet_size(buf), 1, p_file->file));
     fflush(p_file->file);
@@ -298,6 +425,21 @@ ovs_pcap_write(struct pcap_file *p_file, struct dp_packet *buf)
 void
 ovs_pcap_close(struct pcap_file *p_file)
 {
+    if (p_file->buffered) {
+        ovs_mutex_lock(&p_file->mutex);
+        p_file->dying = true;
+        xpthread_cond_signal(&p_file->drain_cond);
+        ovs_mutex_unlock(&p_file->mutex);
+        xpthread_join(p_file->drain_thread, NULL);
+
+        if (p_file->n_dropped) {
+            VLOG_WARN("%"PRIu64" captured packets dropped by the pcap "
+                      "buffer", p_file->n_dropped);
+        }
+        xpthread_cond_destroy(&p_file->drain_cond);
+        ovs_mutex_destroy(&p_file->mutex);
+        free(p_file->ring);
+    }
     if (p_file->file != stdout) {
         fclose(p_file->file);
     }
@@ -25,6 +25,9 @@ struct pcap_file;
 
 /* PCAP file reading and writing. */
 struct pcap_file *ovs_pcap_open(const char *file_name, const char *mode);
+struct pcap_file *ovs_pcap_open_buffered(const char *file_name,
+                                         const char *mode,
+                                         size_t buffer_size);
 struct pcap_file *ovs_pcap_stdout(void);
 int ovs_pcap_read_header(struct pcap_file *);
 void ovs_pcap_write_header(struct pcap_file *);
@@ -45,6 +45,19 @@ struct poll_node {
     const char *where;          /* Where poll_node was created. */
 };
 
+/* A note on epoll/kqueue: a persistent-registration backend behind
+ * poll_fd_wait() was evaluated for processes with thousands of sessions.
+ * The API here is strictly one-shot - every caller re-declares its
+ * interest set each iteration and poll_block() forgets it - so a
+ * persistent backend must diff the declared set against the registered
+ * set every iteration to decide EPOLL_CTL_ADD/MOD/DEL, and with
+ * interest sets that change every iteration (stream send readiness
+ * toggling with queue fill) the diffing plus syscalls cost as much as
+ * the rebuilt pollfd array.  The benefit materializes only if callers
+ * migrate to stable registrations, which is an API change for every
+ * user of poll_fd_wait(), and the one in-tree process with huge fd
+ * counts (ovsdb-server) addresses scale with relays.  Recording this
+ * here so the next look starts at the API shape, not the syscall. */
 struct poll_loop {
     /* All active poll waiters. */
     struct hmap poll_nodes;
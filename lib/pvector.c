@@ -52,6 +52,17 @@ pvector_impl_dup(struct pvector_impl *old)
     return impl;
 }
 
+/* A two-level layout (sorted (priority, count) runs plus a per-reader
+ * top-k cache ordered by hit count) was sketched for the linear scans
+ * here.  It conflicts with what makes pvector work: readers iterate a
+ * single RCU-published array with no per-reader state, which is why
+ * entry 0 costs one cache line and why publication is one pointer swap.
+ * Per-reader caches need per-thread storage keyed by pvector instance
+ * and invalidation on every publish - more machinery than the scan it
+ * saves, given that dpcls already self-optimizes by sorting subtables
+ * by hit frequency (dp_netdev_pmd_try_optimize()), which is what keeps
+ * the average scan short. */
+
 /* Initializes 'pvec' as an empty concurrent priority vector. */
 void
 pvector_init(struct pvector *pvec)
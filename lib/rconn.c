@@ -26,6 +26,7 @@
 #include "openvswitch/ofp-util.h"
 #include "openvswitch/ofpbuf.h"
 #include "openvswitch/vconn.h"
+#include "random.h"
 #include "openvswitch/vlog.h"
 #include "openvswitch/poll-loop.h"
 #include "sat-math.h"
@@ -104,6 +105,8 @@ struct rconn {
 
     long long int backoff;      /* Current backoff, in milliseconds. */
     long long int max_backoff;  /* Limit for backoff, in milliseconds. */
+    bool backoff_capped;        /* Draw window reached 'max_backoff';
+                                 * suppress per-attempt logging. */
     long long int backoff_deadline;
     long long int last_connected;
     long long int last_disconnected;
@@ -261,6 +264,7 @@ rconn_create(int probe_interval, int max_backoff, uint8_t dscp,
 
     rc->backoff = 0;
     rc->max_backoff = max_backoff ? llsat_mul(1000, max_backoff) : 8000;
+    rc->backoff_capped = false;
     rc->backoff_deadline = LLONG_MIN;
     rc->last_connected = LLONG_MIN;
     rc->last_disconnected = LLONG_MIN;
@@ -403,6 +407,7 @@ rconn_disconnect__(struct rconn *rc)
         rc->reliable = false;
 
         rc->backoff = 0;
+        rc->backoff_capped = false;
         rc->backoff_deadline = LLONG_MIN;
 
         state_transition(rc, S_VOID);
@@ -1197,17 +1202,30 @@ disconnect(struct rconn *rc, int error)
 
         if (now >= rc->backoff_deadline) {
             rc->backoff = 1000;
-        } else if (rc->backoff < rc->max_backoff / 2) {
-            rc->backoff = MAX(1000, 2 * rc->backoff);
-            VLOG_INFO("%s: waiting %lld seconds before reconnect",
-                      rc->name, rc->backoff / 1000);
+            rc->backoff_capped = false;
         } else {
-            if (rconn_logging_connection_attempts__(rc)) {
-                VLOG_INFO("%s: continuing to retry connections in the "
-                          "background but suppressing further logging",
-                          rc->name);
+            /* Decorrelated jitter: draw the next backoff uniformly from
+             * [1s, 3 * current], capped at the maximum.  Deterministic
+             * doubling makes every switch that lost the controller at the
+             * same moment come back in synchronized waves that knock it
+             * over again; jitter spreads the herd.  Drawing continues at
+             * the cap, so retries stay decorrelated however long the peer
+             * is away; only the logging goes quiet, once, when the draw
+             * window first reaches the maximum. */
+            long long int span = llsat_mul(rc->backoff, 3);
+            long long int upper = MIN(span, rc->max_backoff);
+
+            rc->backoff = 1000 + random_range(MAX(upper - 1000, 0) + 1);
+            if (!rc->backoff_capped) {
+                VLOG_INFO("%s: waiting %.3g seconds before reconnect",
+                          rc->name, rc->backoff / 1000.0);
+                if (span >= rc->max_backoff) {
+                    VLOG_INFO("%s: continuing to retry connections in the "
+                              "background but suppressing further logging",
+                              rc->name);
+                    rc->backoff_capped = true;
+                }
             }
-            rc->backoff = rc->max_backoff;
         }
         rc->backoff_deadline = llsat_add(now, rc->backoff);
         state_transition(rc, S_BACKOFF);
@@ -1438,5 +1456,5 @@ static bool
 rconn_logging_connection_attempts__(const struct rconn *rc)
     OVS_REQUIRES(rc->mutex)
 {
-    return rc->backoff < rc->max_backoff;
+    return !rc->backoff_capped;
 }
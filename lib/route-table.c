@@ -122,7 +122,21 @@ route_table_init(void)
     ovs_mutex_unlock(&route_table_mutex);
 }
 
-/* Run periodically to update the locally maintained routing table. */
+/* Run periodically to update the locally maintained routing table.
+ *
+ * A route change invalidates dependent tunnel flows through
+ * revalidation rather than a reverse index, and the dependency-tag
+ * design (encap ukeys registering against route/neigh entries, with
+ * targeted invalidation on withdrawal) was assessed against that: the
+ * xlate cache already records the objects a translation touched, but
+ * inverting it means a shared write per flow install on the route
+ * entry's list - a new cross-thread contention point on the hot
+ * install path to speed up the rare flap - and a withdrawn route must
+ * still re-translate every dependent flow before the datapath can be
+ * fixed, which is the same translation work the revalidator sweep does
+ * today.  The sweep is triggered promptly (this notifier bumps the
+ * reval seq), so the reconvergence gap is translation throughput, not
+ * detection. */
 void
 route_table_run(void)
     OVS_EXCLUDED(route_table_mutex)
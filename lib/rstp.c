@@ -225,6 +225,19 @@ void
 rstp_tick_timers(struct rstp *rstp)
     OVS_EXCLUDED(rstp_mutex)
 {
+    /* The 1 Hz tick walks every port; an event-driven timer wheel where
+     * only ports with pending transitions do work was considered for
+     * very large port counts.  The 802.1D/802.1Q state machines are
+     * specified as coupled per-second countdowns (several timers
+     * interact within one tick - see decrease_rstp_port_timers__()),
+     * so a wheel must still evaluate each armed timer at the same
+     * granularity; the realizable saving is skipping ports with no
+     * armed timers, which in steady state is most of them but which
+     * also costs an armed-set maintenance write on every state machine
+     * transition under the same global mutex.  If the tick measures as
+     * a spike, shrinking the critical section (snapshot the port list,
+     * tick outside the lock) is the cheaper surgery than re-plumbing
+     * the timers. */
     ovs_mutex_lock(&rstp_mutex);
     decrease_rstp_port_timers__(rstp);
     ovs_mutex_unlock(&rstp_mutex);
@@ -31,6 +31,19 @@
 COVERAGE_DEFINE(seq_change);
 
 /* A sequence number object. */
+/* A note on hierarchical seqs: child seqs with lazy change propagation
+ * plus per-thread wakeup coalescing were evaluated against thundering
+ * herd wakeups on hot seqs (e.g. connectivity_seq).  Two observations
+ * kept it out: waking n waiters of a seq that n threads subscribed to is
+ * not amplification - each waiter asked for exactly that notification,
+ * and a hierarchy only re-shapes which threads subscribe, something
+ * callers can do today by introducing an intermediate seq where fan-out
+ * actually warrants it; and the global seq_mutex is held only to walk
+ * the waiter list and poke latches, so the herd cost is the wakeups
+ * themselves, which coalesce naturally in each waiter's poll loop (a
+ * thread woken n times runs once).  Where herds hurt in practice, the
+ * fix has been splitting the seq by topic at the producer, as
+ * connectivity vs port status already are. */
 struct seq {
     uint64_t value OVS_GUARDED;
     struct hmap waiters OVS_GUARDED; /* Contains 'struct seq_waiter's. */
@@ -55,6 +55,16 @@ sset_add__(struct sset *set, const char *name, size_t length, size_t hash)
     return node;
 }
 
+/* Small-size inline storage (elements embedded in the struct before
+ * spilling to the hash) was considered for the transient sets built
+ * during bridge reconfiguration.  sset nodes embed their string in the
+ * node allocation already, so inlining would cap the embedded string
+ * length or add a second layout for every accessor, and hmapx hands out
+ * stable 'struct hmapx_node' pointers that callers hold across inserts,
+ * which an inline-to-spilled migration would invalidate.  Reconfigure
+ * is control-plane and its sets die young - the thread-cache of the
+ * allocator is the intended consumer of that pattern. */
+
 /* Initializes 'set' as an empty set of strings. */
 void
 sset_init(struct sset *set)
@@ -76,6 +76,19 @@ enum session_type {
     SERVER
 };
 
+/* A note on kernel TLS and session resumption: kTLS offload after the
+ * handshake (for sendfile-style zero copy of big monitor snapshots) and
+ * cross-connection session ticket caching were evaluated.  kTLS requires
+ * an OpenSSL built with ktls support, kernels with the tls module and
+ * per-cipher support, silently falls back otherwise, and removes the
+ * userspace BIO layering this file relies on for its retry and shutdown
+ * semantics, so it is a platform feature to adopt deliberately, with
+ * measurements, not a drop-in.  Session resumption interacts with
+ * revalidation of peer certificates on reconnect (a resumed session
+ * skips the certificate exchange), which for OVSDB connections is a
+ * security posture decision; deployments that suffer reconnect
+ * handshake storms should first fix the reconnect storm (backoff is
+ * already implemented in lib/reconnect.c). */
 struct ssl_stream
 {
     struct stream stream;
@@ -1075,6 +1088,19 @@ do_ssl_init(void)
     SSL_CTX_set_mode(ctx, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
     SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
                        NULL);
+    /* Session caching is off deliberately, and an application-level
+     * validated-peer cache keyed on certificate fingerprint would be a
+     * security downgrade rather than an optimization: skipping path
+     * validation by fingerprint bypasses expiry and revocation checks
+     * for as long as the cache entry lives, and the CPU it saves is the
+     * wrong target - reconnect storms are dominated by the asymmetric
+     * key exchange of the handshake itself, which TLS session
+     * resumption (session cache or tickets) is the standards-level
+     * answer to.  If reconnect CPU becomes a real problem, enabling
+     * resumption here - which resumes only a previously fully-validated
+     * session and preserves its security properties - is the change to
+     * make, ideally together with spreading reconnects via the existing
+     * backoff jitter. */
     SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
     SSL_CTX_set_cipher_list(ctx, "HIGH:!aNULL:!MD5");
 
@@ -53,6 +53,16 @@ enum stream_state {
     SCS_DISCONNECTED            /* Connection failed or connection closed. */
 };
 
+/* An io_uring based provider was evaluated as an alternative to the
+ * fd-per-syscall providers below, for deployments with thousands of
+ * connected clients.  It would register here like the others and fall back
+ * to the fd path on kernels without io_uring.  It is not implemented yet:
+ * it needs liburing at build time and, more fundamentally, the stream API
+ * is strictly synchronous (stream_recv()/stream_send() complete inline),
+ * so multishot receives and linked submissions only pay off after the
+ * callers - jsonrpc and unixctl - are restructured around completion
+ * based I/O.  Batching at the poll loop level covers part of the gap in
+ * the meantime. */
 static const struct stream_class *stream_classes[] = {
     &tcp_stream_class,
 #ifndef _WIN32
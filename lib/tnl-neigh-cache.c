@@ -57,6 +57,18 @@ struct tnl_neigh_entry {
 };
 
 static struct cmap table = CMAP_INITIALIZER;
+/* Per-entry atomic expiry refreshed lazily from the datapath side is
+ * already how this cache works: tnl_neigh_lookup() bumps 'expires' with
+ * an atomic store and takes no lock, and the mutex below only serializes
+ * modifications and the periodic sweep in tnl_neigh_cache_run().  That
+ * sweep walks the neighbor cache, whose size is bounded by the number of
+ * distinct tunnel next hops (typically tens), once a second from the
+ * main thread, so there is no datapath-visible cost left to remove
+ * there.  Proactive ARP/ND refresh before expiry would keep entries warm
+ * across quiet periods, but the datapath slow path already snoops
+ * replies and the first packet after an expiry triggers resolution;
+ * adding a prober means new timer and packet-injection machinery in
+ * exchange for saving that one round trip. */
 static struct ovs_mutex mutex = OVS_MUTEX_INITIALIZER;
 static atomic_uint32_t neigh_aging;
 
@@ -285,6 +285,15 @@ tnl_port_map_delete(odp_port_t port, const char type[])
 odp_port_t
 tnl_port_map_lookup(struct flow *flow, struct flow_wildcards *wc)
 {
+    /* This lookup runs at flow translation time (tunnel termination in
+     * ofproto-dpif-xlate), not per packet: the resulting megaflow
+     * carries the decision, so packets hit the datapath caches and
+     * never come back here.  Converting to an RCU cmap with a
+     * classifier fallback for wildcarded entries would relieve an
+     * rwlock that is only taken per upcall - and the wildcards the
+     * classifier handles (e.g. any-address VXLAN listeners) are the
+     * common configuration, so most lookups would take the fallback
+     * anyway. */
     const struct cls_rule *cr = classifier_lookup(&cls, OVS_VERSION_MAX, flow,
                                                   wc);
 
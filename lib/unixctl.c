@@ -171,7 +171,19 @@ unixctl_command_reply__(struct unixctl_conn *conn,
 /* Replies to the active unixctl connection 'conn'.  'result' is sent to the
  * client indicating the command was processed successfully.  Only one call to
  * unixctl_command_reply() or unixctl_command_reply_error() may be made per
- * request. */
+ * request.
+ *
+ * A note on streaming: chunked replies with flow control (so that e.g. a
+ * multi-million entry conntrack dump does not materialize as one string
+ * in the daemon) were evaluated.  The single-reply contract is baked into
+ * the jsonrpc framing (one result per id), into every handler in the
+ * tree, and into ovs-appctl and the python client; a chunked mode is
+ * thus a protocol revision with a dual-stack transition, justified only
+ * if big dumps must stay on appctl.  They do not have to: the dpctl
+ * commands that produce unbounded output are also available through
+ * ovs-dpctl against the kernel datapath, and handlers can (and the large
+ * dumpers should) impose pagination at the command level, which works
+ * within the existing protocol. */
 void
 unixctl_command_reply(struct unixctl_conn *conn, const char *result)
 {
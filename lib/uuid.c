@@ -206,6 +206,37 @@ uuid_is_zero(const struct uuid *uuid)
             && !uuid->parts[2] && !uuid->parts[3]);
 }
 
+/* Formats 'uuid' into 'dst', which must have room for UUID_LEN + 1 bytes,
+ * writing the usual lowercase UUID format and a null terminator.  This is
+ * substantially faster than formatting through printf, which matters when
+ * serializing large databases. */
+void
+uuid_to_string(char dst[UUID_LEN + 1], const struct uuid *uuid)
+{
+    static const char hex[16] = "0123456789abcdef";
+    int di = 0;
+
+    for (int d = 0; d < 32; d++) {
+        uint8_t nibble = (uuid->parts[d / 8] >> ((7 - d % 8) * 4)) & 0xf;
+
+        if (di == 8 || di == 13 || di == 18 || di == 23) {
+            dst[di++] = '-';
+        }
+        dst[di++] = hex[nibble];
+    }
+    dst[di] = '\0';
+}
+
+/* Like uuid_to_string() but returns a malloc'd string. */
+char *
+uuid_to_string_alloc(const struct uuid *uuid)
+{
+    char *s = xmalloc(UUID_LEN + 1);
+
+    uuid_to_string(s, uuid);
+    return s;
+}
+
 /* Compares 'a' and 'b'.  Returns a negative value if 'a < b', zero if 'a ==
  * b', or positive if 'a > b'.  The ordering is lexicographical order of the
  * conventional way of writing out UUIDs as strings. */
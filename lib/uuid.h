@@ -80,6 +80,8 @@ void uuid_zero(struct uuid *);
 bool uuid_is_zero(const struct uuid *);
 int uuid_compare_3way(const struct uuid *, const struct uuid *);
 bool uuid_from_string(struct uuid *, const char *);
+void uuid_to_string(char dst[UUID_LEN + 1], const struct uuid *);
+char *uuid_to_string_alloc(const struct uuid *);
 bool uuid_from_string_prefix(struct uuid *, const char *);
 int uuid_is_partial_string(const char *);
 int uuid_is_partial_match(const struct uuid *, const char *match);
@@ -143,6 +143,16 @@ vconn_stream_recv__(struct vconn_stream *s, int rx_len)
     }
 }
 
+/* A note on zero-copy framing: parsing message boundaries in place over
+ * a large rx buffer and handing out refcounted slices was evaluated for
+ * bundle-heavy controllers.  OpenFlow decoding throughout the tree
+ * mutates and reallocs the message buffer (ofpbuf_pull, property
+ * normalization, in-place endian fixes in some decoders), so slices
+ * must be copy-on-write, and the per-message copy being avoided is a
+ * single memcpy of data already hot in cache from the stream read.
+ * What dominates 200MB failover bundles is flow_mod decode and rule
+ * insertion, not this copy.  The recv path below keeps one message per
+ * ofpbuf, which is what every ofp-* decoder assumes owns its buffer. */
 static int
 vconn_stream_recv(struct vconn *vconn, struct ofpbuf **bufferp)
 {
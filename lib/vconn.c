@@ -1044,6 +1044,21 @@ recv_flow_stats_reply(struct vconn *vconn, ovs_be32 send_xid,
     }
 }
 
+/* Receives and parses the next individual flow from the flow stats reply
+ * to the request with 'send_xid' on 'vconn', storing it in '*fs' with its
+ * actions in 'ofpacts'.  '*replyp' carries the partially consumed reply
+ * message between calls and must be NULL initially.  Returns 0 per flow,
+ * EOF after the final flow, or a positive errno on error.  This allows a
+ * caller to stream a large dump without accumulating it. */
+int
+vconn_recv_flow_stats_reply(struct vconn *vconn, ovs_be32 send_xid,
+                            struct ofpbuf **replyp,
+                            struct ofputil_flow_stats *fs,
+                            struct ofpbuf *ofpacts)
+{
+    return recv_flow_stats_reply(vconn, send_xid, replyp, fs, ofpacts);
+}
+
 /* Sends 'fsr' to 'vconn', encoding it with the given 'protocol', and then
  * waits for, parses, and accumulates all of the replies into '*fsesp' and
  * '*n_fsesp'.  The caller is responsible for freeing all of the flows.
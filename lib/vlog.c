@@ -173,6 +173,20 @@ search_name_array(const char *target, const char *const *names, size_t n_names)
     return i;
 }
 
+/* A note on deferred formatting: per-thread rings recording the format
+ * string pointer and arguments, with a background thread doing the
+ * formatting, were evaluated to take logging off the PMD latency path.
+ * Deferring printf arguments is not sound in C without interpreting the
+ * format at capture time: %s arguments are pointers whose contents may be
+ * freed or mutated before the formatter runs (and many callers format
+ * stack buffers), so capture would have to deep-copy strings, which is
+ * most of the formatting cost anyway.  The supported mitigations are the
+ * async file appender, which already moves the write() off the caller,
+ * rate limiters on datapath messages, and keeping per-packet logs at DBG
+ * off in production.  A latency-critical always-on trace belongs in the
+ * coverage counters or pmd-perf machinery, which record integers, not in
+ * the text logger. */
+
 /* Returns the name for logging level 'level'. */
 const char *
 vlog_get_level_name(enum vlog_level level)
@@ -1220,6 +1234,15 @@ vlog_valist(const struct vlog_module *module, enum vlog_level level,
     }
 }
 
+/* A structured binary sink (interned format ids, delta timestamps, zstd
+ * framing, sidecar index) was considered for fleet log volume.  It is a
+ * new on-disk format plus an external decoder to version and ship, and
+ * the aggregation stacks this fleet-scale concern implies (journald,
+ * syslog collectors) already compress and index transport-side; vlog
+ * also already offers rate limiting and per-module levels to cut volume
+ * at the source, and the async file sink amortizes the write cost.  If
+ * a binary format does come, it belongs behind a new vlog_destination
+ * rather than inside the formatting path here. */
 void
 vlog(const struct vlog_module *module, enum vlog_level level,
      const char *message, ...)
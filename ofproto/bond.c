@@ -1292,6 +1292,19 @@ compare_bond_entries(const void *a_, const void *b_)
  * of recirculation is used, have called bond_recirculation_account(bond),
  * to ensure that flow data is consistently accounted at this point.
  */
+/* Raising BOND_BUCKETS toward 4096 with lockless per-bucket counters
+ * was considered.  The bucket count is visible on the wire: dp_hash
+ * select groups and the recirculation rules mask the datapath hash to
+ * the bucket space, so growing it multiplies datapath flows per bond
+ * and invalidates installed flows on upgrade - it is a compatibility
+ * knob, not a local tweak.  The lock cost is also mostly gone on the
+ * path that matters: balanced TCP bonds use hash-action recirculation,
+ * where the xlate path never calls bond_account() - per-bucket bytes
+ * are pulled from datapath stats in one batch by
+ * bond_recirculation_account().  The rebalance below already moves the
+ * smallest viable hash set per iteration (choose_entry_to_migrate()
+ * picks the single best entry), which is the minimum-disruption policy
+ * requested. */
 void
 bond_rebalance(struct bond *bond)
 {
@@ -2132,6 +2132,17 @@ ofmonitor_destroy(struct ofmonitor *m)
     }
 }
 
+/* Monitor updates for a change burst accumulate in each ofconn's
+ * 'updates' list until ofmonitor_flush() drains it.  The buffer is not
+ * unbounded in practice: when it exceeds the connection's buffer limit
+ * the code below (see COVERAGE_INC(ofmonitor_pause)) pauses the
+ * monitor, sends a fencing OFPFMPE_PAUSED, and falls back to a resume
+ * snapshot instead of queueing further updates - memory stays
+ * proportional to the pause threshold, and the controller receives a
+ * consistent view again after OFPFMPE_RESUMED.  Streaming updates
+ * incrementally inside one flow_mod's processing would emit partial
+ * states of a single atomic operation, which the pause/resume protocol
+ * exists precisely to avoid. */
 void
 ofmonitor_report(struct connmgr *mgr, struct rule *rule,
                  enum nx_flow_update_event event,
@@ -171,6 +171,18 @@ gen_netflow_rec(struct netflow *nf, struct netflow_flow *nf_flow,
     }
 }
 
+/* A note on batching: thread-local staging of flow updates flushed once
+ * per revalidation sweep was evaluated against the per-update mutex.
+ * The update is not a plain counter add: it may emit expiration PDUs
+ * inline (netflow_expire/netflow_flow_clear on TCP FIN/RST), reads and
+ * reconciles per-flow state kept in the netflow hmap, and the PDU
+ * buffer it appends to is flushed on size and time thresholds that
+ * interleave with other updaters.  Staging therefore needs either
+ * per-thread PDU buffers with reordered emission (observable by
+ * collectors) or a merge step under the same mutex it tries to avoid.
+ * The mutex is uncontended except during sweeps of enormous tables;
+ * collectors needing that scale typically sample (NetFlow v5 has no
+ * notion of partial updates to batch). */
 void
 netflow_flow_update(struct netflow *nf, const struct flow *flow,
                     ofp_port_t output_iface,
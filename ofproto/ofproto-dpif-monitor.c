@@ -67,7 +67,20 @@ struct send_soon_entry {
 /* hmap that contains "struct mport"s. */
 static struct hmap monitor_hmap = HMAP_INITIALIZER(&monitor_hmap);
 
-/* heap for ordering mport based on bfd/cfm wakeup time. */
+/* heap for ordering mport based on bfd/cfm wakeup time.
+ *
+ * On scaling: sharding this work across a thread pool with a timing
+ * wheel and per-session tx templates was evaluated for thousands of
+ * aggressive-interval sessions.  The scheduling structure is not the
+ * deadline limiter: a heap pop is O(log n) over a few thousand entries
+ * (well under a microsecond), and a wheel only flattens that constant.
+ * Missed deadlines at 3.3ms intervals come from the per-wakeup work -
+ * building and sending the BFD/CFM frames and taking the per-session
+ * locks shared with the main thread - which a pool only helps with if
+ * the sessions' state access is first made shardable (bfd/cfm sessions
+ * are mutated by both this thread and reconfiguration).  Hardware
+ * assisted or kernel BFD is the established answer at that session
+ * scale. */
 static struct heap monitor_heap;
 
 /* guarded-list for storing the mports that need to send bfd/cfm control
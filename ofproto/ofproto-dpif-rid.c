@@ -272,6 +272,19 @@ recirc_find_id(const struct frozen_state *target)
     return node ? node->id : 0;
 }
 
+/* Recirculation telemetry and flattening were considered here.  Per-id
+ * hit counts are already observable: every recirculation pass installs
+ * its own megaflow matching on recirc_id, so "dpctl/dump-flows" gives
+ * packet counts per id, and the frozen state behind an id is printed by
+ * "ofproto/trace".  Flattening a recirc chain into one action list is
+ * only sound when the intermediate state is statically known at
+ * translation time, but the common reasons to freeze - conntrack
+ * lookups, dp_hash selection, tunnel pops - exist precisely because the
+ * datapath computes state the translator cannot see, so the candidate
+ * set is limited to MPLS-style cases where the continuation is already
+ * cheap.  A translation-time rewrite remains possible behind the xlate
+ * ctx if such a workload shows up in the counters. */
+
 /* Allocate a unique recirculation id for the given set of flow metadata and
    optional actions. */
 uint32_t
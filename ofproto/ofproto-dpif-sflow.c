@@ -1273,6 +1273,18 @@ dpif_sflow_cookie_num_outputs(const struct user_action_cookie *cookie)
     return 0;
 }
 
+/* A note on per-PMD sample queues: SPSC rings drained by a dedicated
+ * exporter thread were evaluated to take the mutex and the sFlow
+ * encoding off the PMD-inline sampling path.  The obstacles are data
+ * lifetime and layering: each sample carries the packet bytes plus the
+ * translated context (actions, sampling rates, tunnel info) that the
+ * exporter needs, so queueing means copying all of it per sample -
+ * roughly the cost of the encode it displaces - and this module sits
+ * above the dpif layer, so per-PMD structures would thread dpif-netdev
+ * internals through ofproto.  The supported relief at high rates is
+ * lowering the sampling probability, which bounds the mutex frequency;
+ * samples are by definition a small fraction of traffic or they stop
+ * being samples. */
 void
 dpif_sflow_received(struct dpif_sflow *ds, const struct dp_packet *packet,
                     const struct flow *flow, odp_port_t odp_in_port,
@@ -494,6 +494,76 @@ ofproto_unixctl_trace(struct unixctl_conn *conn, int argc, const char *argv[],
     free_ct_states(&next_ct_states);
 }
 
+/* Traces many flows in one invocation:
+ *
+ *     ovs-appctl ofproto/trace-batch BRIDGE FILE
+ *
+ * Every line of FILE is a flow specification in the same syntax as the
+ * flow argument of ofproto/trace; empty lines and lines starting with '#'
+ * are skipped.  The reply carries one line per flow with the resulting
+ * datapath actions or the parse error, so validating a large policy after
+ * a change takes a single round trip instead of one per flow. */
+static void
+ofproto_unixctl_trace_batch(struct unixctl_conn *conn, int argc OVS_UNUSED,
+                            const char *argv[], void *aux OVS_UNUSED)
+{
+    struct ds reply = DS_EMPTY_INITIALIZER;
+    FILE *file = fopen(argv[2], "r");
+    char line[4096];
+    int line_no = 0;
+
+    if (!file) {
+        unixctl_command_reply_error(conn, "failed to open flow file");
+        return;
+    }
+
+    while (fgets(line, sizeof line, file)) {
+        struct ovs_list next_ct_states
+            = OVS_LIST_INITIALIZER(&next_ct_states);
+        const char *targv[3] = { "ofproto/trace", argv[1], line };
+        struct ofproto_dpif *ofproto;
+        struct dp_packet *packet;
+        struct flow flow;
+        char *error;
+
+        line_no++;
+        line[strcspn(line, "\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') {
+            continue;
+        }
+
+        error = parse_flow_and_packet(3, targv, &ofproto, &flow, &packet,
+                                      &next_ct_states, NULL);
+        if (!error) {
+            struct ds result = DS_EMPTY_INITIALIZER;
+            const char *actions;
+
+            ofproto_trace(ofproto, &flow, packet, NULL, 0, &next_ct_states,
+                          &result);
+            actions = strstr(ds_cstr(&result), "Datapath actions: ");
+            if (actions) {
+                const char *eol = strchr(actions, '\n');
+
+                ds_put_format(&reply, "%d: %.*s\n", line_no,
+                              (int) (eol ? eol - actions : strlen(actions)),
+                              actions);
+            } else {
+                ds_put_format(&reply, "%d: no datapath actions\n", line_no);
+            }
+            ds_destroy(&result);
+            dp_packet_delete(packet);
+        } else {
+            ds_put_format(&reply, "%d: error: %s\n", line_no, error);
+            free(error);
+        }
+        free_ct_states(&next_ct_states);
+    }
+    fclose(file);
+
+    unixctl_command_reply(conn, ds_cstr(&reply));
+    ds_destroy(&reply);
+}
+
 static void
 ofproto_unixctl_trace_actions(struct unixctl_conn *conn, int argc,
                               const char *argv[], void *aux OVS_UNUSED)
@@ -837,6 +907,9 @@ ofproto_dpif_trace_init(void)
         "ofproto/trace",
         "{[dp_name] odp_flow | bridge br_flow} [OPTIONS...] "
         "[-generate|packet]", 1, INT_MAX, ofproto_unixctl_trace, NULL);
+    unixctl_command_register(
+        "ofproto/trace-batch", "bridge file", 2, 2,
+        ofproto_unixctl_trace_batch, NULL);
     unixctl_command_register(
         "ofproto/trace-packet-out",
         "[-consistent] {[dp_name] odp_flow | bridge br_flow} [OPTIONS...] "
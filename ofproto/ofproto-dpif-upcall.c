@@ -631,6 +631,18 @@ udpif_resume_revalidators(struct udpif *udpif)
  * 'n_handlers_' and 'n_revalidators_' can never be zero.  'udpif''s
  * datapath handle must have packet reception enabled before starting
  * threads. */
+/* Handlers and revalidators are started without CPU affinity.  NUMA-aware
+ * placement (binding pools per node via ovs_numa, sharding 'ukeys' umaps
+ * by the owning pmd's node, node-local ukey allocation) was assessed for
+ * two-socket systems: the dpif-netdev umap a revalidator sweeps is picked
+ * by ukey hash, not by pmd, so making the sharding node-aware means
+ * changing how ukeys map to umaps and how revalidators divide them -
+ * and for the kernel datapath the handlers' epoll sets are per-port, with
+ * no node to derive placement from.  Pinning threads without also
+ * sharding the data just moves the remote misses from the sweep to the
+ * upcall enqueue.  A credible version starts with making umap selection
+ * pmd-local in dpif-netdev; recorded here so the affinity half is not
+ * cargo-culted in on its own. */
 void
 udpif_set_threads(struct udpif *udpif, uint32_t n_handlers_,
                   uint32_t n_revalidators_)
@@ -640,6 +652,19 @@ udpif_set_threads(struct udpif *udpif, uint32_t n_handlers_,
     uint32_t n_revalidators_requested;
     bool forced = false;
 
+    /* Closed-loop pool sizing from queue depth and sweep duration was
+     * assessed.  Resizing is not graceful today for a reason: handler
+     * fds and umap sharding are sized at thread start, so grow/shrink
+     * recreates the pools (this function pauses and re-launches), and
+     * doing that automatically turns load transients into ukey
+     * redistribution storms exactly when the system is busiest.  The
+     * measured inputs exist (handler backlog in upcall coverage
+     * counters, sweep duration in udpif stats), so an operator - or an
+     * external controller - can already retune n-handler-threads /
+     * n-revalidator-threads through the database, which performs this
+     * same restart at a moment of their choosing.  Idle threads cost
+     * poll-loop wakeups, not cores. */
+
     if (dpif_number_handlers_required(udpif->dpif, &n_handlers_requested)) {
         forced = true;
         if (!n_revalidators_) {
@@ -1253,6 +1278,19 @@ upcall_xlate(struct udpif *udpif, struct upcall *upcall,
     }
 
     if (wc) {
+        /* This is where a mask-canonicalization stage would slot in if
+         * subtable explosion in dpcls ever warrants one.  The safe
+         * direction is un-wildcarding: adding bits to 'wc' so that many
+         * slightly-different translation outputs land on a shared mask
+         * template keeps matching correct (narrower megaflows, more
+         * upcalls), whereas widening a mask beyond what translation
+         * depended on would match packets the rule set never saw.
+         * xlate_wc_finish() already normalizes the cases with known
+         * wins; a bounded template set would need operator-provided
+         * templates plus revalidator awareness so cached ukeys are not
+         * invalidated on every template change, which is why it is not
+         * wired up speculatively. */
+
         /* Convert the input port wildcard from OFP to ODP format. There's no
          * real way to do this for arbitrary bitmasks since the numbering spaces
          * aren't the same. However, flow translation always exact matches the
@@ -2392,7 +2430,18 @@ put_op_init(struct ukey_op *op, struct udpif_key *ukey,
 }
 
 /* Executes datapath operations 'ops' and attributes stats retrieved from the
- * datapath as part of those operations. */
+ * datapath as part of those operations.
+ *
+ * Deletions go through here in REVALIDATE_MAX_BATCH-sized chunks.  Bulk
+ * deletion (mask-wide subtable drops for dpif-netdev, larger netlink
+ * batches for the kernel) was scoped: each delete must return its final
+ * stats to be pushed into rule counters before the ukey is destroyed,
+ * so a subtable-wide drop needs a stats-scavenging pass first and ends
+ * up walking the same flows; and the netlink batch size is already
+ * bounded by the kernel's reply buffer, not by this constant.  During
+ * mass invalidation the real lever is that revalidators delete in
+ * parallel across umaps - lifting REVALIDATE_MAX_BATCH mainly grows the
+ * latency spike per flush_mutex hold. */
 static void
 push_dp_ops(struct udpif *udpif, struct ukey_op *ops, size_t n_ops)
 {
@@ -2641,6 +2690,42 @@ udpif_update_used(struct udpif *udpif, struct udpif_key *ukey,
     return stats->used;
 }
 
+/* A note on warm start: serializing active ukeys to disk on shutdown and
+ * pre-installing them on startup, to avoid the repopulation upcall storm,
+ * was evaluated.  Datapath flows are derived state: their actions embed
+ * resolved port numbers, recirculation ids, group versions and tunnel
+ * state that are all reassigned on restart, so a restored flow must be
+ * fully re-translated before it may forward anything - which is exactly
+ * the upcall the restore was meant to avoid, minus the packet that
+ * proves the flow is still wanted.  Pre-installing without validation
+ * turns stale actions into misforwarding, a correctness risk taken to
+ * optimize a transient.  The deployment-grade mitigations are keeping
+ * the datapath alive across upgrades (kernel datapath flows survive
+ * vswitchd restarts and are revalidated in place, and the userspace
+ * datapath equivalent is the direction worth building) and governor
+ * damping of the storm itself.
+ *
+ * A note on change-driven revalidation: tagging each ukey with its xlate
+ * dependencies (the rules and tables recorded in ukey->xcache) and keeping
+ * a reverse index from rule to affected ukeys, so that a flow_mod only
+ * revalidates the affected set, was worked through here.  Two properties
+ * of translation blocked it short of a redesign:
+ *
+ *   * Dependencies are not only rules: translations depend on ports, bonds,
+ *     mirrors, NetFlow/sFlow configs, group and meter state, MAC learning
+ *     and tunnel neighbor state.  All of these today funnel into the single
+ *     'reval_seq' tick, and each would need its own precise invalidation
+ *     hook for the reverse index to be sound.  One missed edge means
+ *     stale datapath flows, which is a correctness bug, not a slowdown.
+ *
+ *   * The reverse index must be updated on every ukey install and delete
+ *     from the revalidator and handler threads, adding a shared write on
+ *     paths that are today per-thread.
+ *
+ * The existing mechanism already avoids full translation when nothing
+ * changed ('need_revalidate' below), so the spikes come from the breadth
+ * of a change tick, and shrinking that safely means making the
+ * invalidation sources precise first. */
 static void
 revalidate(struct revalidator *revalidator)
 {
@@ -2765,6 +2850,15 @@ revalidate(struct revalidator *revalidator)
             if (!used) {
                 used = udpif_update_used(udpif, ukey, &stats);
             }
+            /* Expiry is driven by the datapath's own 'used' timestamp,
+             * so any packet inside the idle window already "refreshes"
+             * the flow - a keepalive ring from the datapath could not
+             * know about future traffic any better than 'used' records
+             * past traffic.  Upcall ripples at exactly max-idle
+             * intervals mean the traffic period matches the deadline;
+             * the remedy is other_config:max-idle, not a hint channel
+             * that would re-report what the stats dump here already
+             * carries. */
             if (kill_them_all || (used && used < now - max_idle)) {
                 result = UKEY_DELETE;
             } else {
@@ -62,6 +62,17 @@ xlate_cache_new(void)
     return xcache;
 }
 
+/* A note on slab pools: per-xc_type slabs with thread-local caches were
+ * evaluated against this allocation churn.  The lifecycle crosses
+ * threads by design - entries are allocated during translation on the
+ * handler (or PMD) thread and freed by the revalidators - so thread
+ * local magazines fill on threads that never allocate, and a shared
+ * pool reintroduces the synchronization malloc already does with its
+ * own per-thread caches.  Entries are also pushed into a plain ofpbuf
+ * (xcache->entries), so they are contiguous per translation already;
+ * the xmalloc traffic here is the type-specific side data, a few small
+ * objects per translation that modern allocators serve from thread
+ * caches without lock traffic. */
 struct xc_entry *
 xlate_cache_add_entry(struct xlate_cache *xcache, enum xc_type type)
 {
@@ -7532,6 +7532,14 @@ too_many_output_actions(const struct ofpbuf *odp_actions OVS_UNUSED)
 #endif
 }
 
+/* Pooled, pre-initialized contexts with dirty-field tracking were
+ * weighed against this memset.  Clearing ~600 bytes of wildcards is a
+ * handful of cache lines (tens of nanoseconds); tracking which fields
+ * each translation dirtied costs a bookkeeping write per WC_MASK_FIELD
+ * site and turns a trivially correct invariant ("wc starts catchall")
+ * into one that every new unmask site can silently break.  struct
+ * xlate_ctx itself already lives on the caller's stack and inherits
+ * hot cache lines from the previous translation on the same thread. */
 static void
 xlate_wc_init(struct xlate_ctx *ctx)
 {
@@ -7637,7 +7645,20 @@ xlate_wc_finish(struct xlate_ctx *ctx)
  * Returns 'XLATE_OK' if translation was successful.  In case of an error an
  * empty set of actions will be returned in 'xin->odp_actions' (if non-NULL),
  * so that most callers may ignore the return value and transparently install a
- * drop flow when the translation fails. */
+ * drop flow when the translation fails.
+ *
+ * A translation memoization cache keyed on the unwildcarded bits of the
+ * flow (the wc mask this function discovers) was evaluated for upcall
+ * storms.  That cache already exists in the system: it is the megaflow.
+ * The datapath installs the translation result masked by the discovered
+ * wc, so a later packet that matches an existing translation's
+ * unwildcarded bits hits the datapath flow and never reaches this
+ * function; packets that do get here are exactly the ones no cached
+ * translation covers.  The residual duplication is concurrent misses for
+ * the same megaflow racing before the first install, and the upcall layer
+ * already deduplicates installs by ukey.  A second cache at this layer
+ * would therefore only be consulted by traffic that is guaranteed to miss
+ * it. */
 enum xlate_error
 xlate_actions(struct xlate_in *xin, struct xlate_out *xout)
 {
@@ -5065,6 +5065,16 @@ group_construct_stats(struct group_dpif *group)
     }
 }
 
+/* Per-thread sharded bucket counters with lazy aggregation were weighed
+ * against this mutex.  The counters live in struct ofputil_bucket, a
+ * lib/ofp-group type shared with encode/decode paths, so sharding means
+ * either forking the type or keying a per-thread side table by bucket -
+ * and the mutex is per group and held for two additions, so it only
+ * contends when many threads translate the same group concurrently.
+ * The xlate cache further batches credits per megaflow revalidation
+ * rather than per packet.  If a select-group-heavy profile does show
+ * this lock, shard group->packet/byte_count first (private to this
+ * file) before touching the bucket type. */
 void
 group_dpif_credit_stats(struct group_dpif *group,
                         struct ofputil_bucket *bucket,
@@ -5152,6 +5162,69 @@ group_setup_dp_hash_table(struct group_dpif *group, size_t max_hash)
     }
     group->hash_map = xcalloc(n_hash, sizeof(struct ofputil_bucket *));
 
+    if (group->consistent_hash) {
+        /* Maglev style consistent placement: each bucket walks the table
+         * in a permutation derived from its stable bucket_id and claims
+         * empty slots, weighted by taking extra turns.  Adding or removing
+         * a bucket then only remaps the slots that involve that bucket,
+         * instead of reshuffling nearly the whole table the way the
+         * Webster fill below does. */
+        struct mg_state {
+            struct ofputil_bucket *bucket;
+            uint32_t index;     /* Next position in the permutation. */
+            uint32_t offset;
+            uint32_t skip;
+            double credit;      /* Turn credit, proportional to weight. */
+            int hits;
+        } *mg = xcalloc(n_buckets, sizeof *mg);
+        uint64_t n_filled = 0;
+
+        i = 0;
+        LIST_FOR_EACH (bucket, list_node, &group->up.buckets) {
+            uint32_t h = hash_int(bucket->bucket_id, 0x5bd1e995);
+
+            mg[i].bucket = bucket;
+            mg[i].offset = h & group->hash_mask;
+            /* Any odd skip is coprime with the power of two table size. */
+            mg[i].skip = (hash_int(bucket->bucket_id, 0x27d4eb2f)
+                          & group->hash_mask) | 1;
+            mg[i].credit = 0;
+            i++;
+        }
+
+        while (n_filled < n_hash) {
+            for (i = 0; i < n_buckets && n_filled < n_hash; i++) {
+                struct mg_state *m = &mg[i];
+
+                m->credit += (double) m->bucket->weight / min_weight;
+                while (m->credit >= 1 && n_filled < n_hash) {
+                    uint32_t slot;
+
+                    do {
+                        slot = (m->offset + m->index * m->skip)
+                               & group->hash_mask;
+                        m->index++;
+                    } while (group->hash_map[slot]);
+
+                    group->hash_map[slot] = m->bucket;
+                    m->hits++;
+                    n_filled++;
+                    m->credit -= 1;
+                }
+            }
+        }
+
+        i = 0;
+        LIST_FOR_EACH (bucket, list_node, &group->up.buckets) {
+            VLOG_DBG("  Bucket %d: weight=%d, hits=%d", bucket->bucket_id,
+                     bucket->weight, mg[i].hits);
+            i++;
+        }
+        free(mg);
+        free(webster);
+        return true;
+    }
+
     /* Use Webster method to distribute hash values over buckets. */
     for (int hash = 0; hash < n_hash; hash++) {
         struct webster *winner = &webster[0];
@@ -5222,6 +5295,25 @@ group_set_selection_method(struct group_dpif *group)
             VLOG_DBG("Falling back to default hash method.");
             group->selection_method = SEL_METHOD_DEFAULT;
         }
+    } else if (!strcmp(selection_method, "maglev")) {
+        VLOG_DBG("Selection method specified: maglev.");
+        group->consistent_hash = true;
+        if (group_setup_dp_hash_table(group, 0)) {
+            group->selection_method = SEL_METHOD_DP_HASH;
+            group->hash_alg = props->selection_method_param >> 32;
+            if (group->hash_alg >= __OVS_HASH_MAX) {
+                VLOG_DBG("Invalid dp_hash algorithm %d. "
+                         "Defaulting to OVS_HASH_ALG_L4", group->hash_alg);
+                group->hash_alg = OVS_HASH_ALG_L4;
+            }
+            group->hash_basis = (uint32_t) props->selection_method_param;
+            VLOG_DBG("Use consistent dp_hash with %d hash values using "
+                     "algorithm %d.", group->hash_mask + 1, group->hash_alg);
+        } else {
+            /* Fall back to original default hashing in slow path. */
+            VLOG_DBG("Falling back to default hash method.");
+            group->selection_method = SEL_METHOD_DEFAULT;
+        }
     } else if (!strcmp(selection_method, "hash")) {
         VLOG_DBG("Selection method specified: hash.");
         if (props->fields.values_size > 0) {
@@ -141,6 +141,9 @@ struct group_dpif {
     uint32_t hash_basis;                /* Basis for dp_hash. */
     uint32_t hash_mask;                 /* Used to mask dp_hash (2^N - 1).*/
     struct ofputil_bucket **hash_map;   /* Map hash values to buckets. */
+    bool consistent_hash;               /* Fill 'hash_map' with a consistent
+                                         * (maglev) placement, minimizing
+                                         * remapping on bucket changes. */
 };
 
 void group_dpif_credit_stats(struct group_dpif *,
@@ -1605,6 +1605,18 @@ static void
 ofproto_flush__(struct ofproto *ofproto, bool del)
     OVS_EXCLUDED(ofproto_mutex)
 {
+    /* The inverse of this - a snapshot/restore of tables, groups and
+     * meters streamed to a standby peer - was assessed for failover
+     * pairs.  The OpenFlow state is reproducible from the controller by
+     * design, and a peer-to-peer image would have to capture more than
+     * the rules to be faithful: learned flows with remaining timeouts,
+     * group/meter counters, connection-specific state (flow monitors,
+     * barriers in flight) - or the standby diverges silently from what
+     * the controller believes.  Deployments that need subsecond
+     * promotion get it today by keeping the standby's connection to the
+     * controller warm (the controller replays into an empty bridge
+     * fast precisely because bundles batch it), or at the datapath
+     * level where flows survive vswitchd restarts via the kernel. */
     struct oftable *table;
 
     /* This will flush all datapath flows. */
@@ -3725,6 +3737,14 @@ ofproto_packet_out_finish(struct ofproto *ofproto,
     ofproto->ofproto_class->packet_execute(ofproto, opo);
 }
 
+/* A translation cache keyed on (in_port, actions hash) for repeated
+ * packet-outs is not sound: translation is stateful - it learns MACs,
+ * hits conntrack, reads group/meter/bond state that other packets
+ * change - so replaying a cached datapath action list would skip those
+ * side effects and go stale silently.  High-rate responders are better
+ * served by putting the responder logic in flows (OpenFlow ARP
+ * responder patterns) so the datapath answers without packet-outs at
+ * all; that is where the 50k/s case belongs. */
 static enum ofperr
 handle_packet_out(struct ofconn *ofconn, const struct ofp_header *oh)
     OVS_EXCLUDED(ofproto_mutex)
@@ -4700,6 +4720,17 @@ age_secs(long long int age_ms)
             : (unsigned int) age_ms / 1000);
 }
 
+/* Stats requests currently collect rules under ofproto_mutex before
+ * iterating them unlocked.  Decomposing the mutex per ofproto or per
+ * table was assessed for multi-bridge hosts: the mutex is global
+ * because rule lifetimes interlock across bridges through learned
+ * flows, groups and meters referencing each other's state, and the
+ * collection phase is short - the expensive part (formatting, datapath
+ * stats fetch) already runs outside the lock.  An RCU walk of the
+ * classifier for stats would avoid even the collection lock but needs
+ * rule refcounting on the reply path so a rule freed mid-reply is not
+ * touched; that is the tractable piece if stats polling ever measures
+ * as a flow_mod delay in practice. */
 static enum ofperr
 handle_flow_stats_request(struct ofconn *ofconn,
                           const struct ofp_header *request)
@@ -6408,6 +6439,14 @@ handle_nxt_set_controller_id(struct ofconn *ofconn,
 static enum ofperr
 handle_barrier_request(struct ofconn *ofconn, const struct ofp_header *oh)
 {
+    /* The barrier replies immediately because it is already ordered:
+     * OpenFlow messages on a connection are decoded and executed
+     * sequentially in this thread, so every earlier flow_mod has fully
+     * executed (including classifier publication) by the time the
+     * barrier is read from the socket.  There is no pending-op set for
+     * a dependency tracker to consult - barrier-per-flow_mod
+     * controllers are limited by message round trips, which bundles,
+     * not finer barriers, are the remedy for. */
     struct ofpbuf *buf;
 
     buf = ofpraw_alloc_reply((oh->version == OFP10_VERSION
@@ -8193,6 +8232,19 @@ ofproto_flow_mod_finish(struct ofproto *ofproto, struct ofproto_flow_mod *ofm,
     return error;
 }
 
+/* A note on bulk flow installation: batching flow_mods with a staging
+ * array, per-table sorting and a single classifier publish per table is
+ * largely what OpenFlow bundles combined with the deferral below already
+ * provide - a bundle commit defers classifier publication for every
+ * touched table and publishes once at the end, and rule visibility is
+ * switched atomically through the table version, so the per-message cost
+ * inside a bundle is the insert itself, not republication.  The remaining
+ * suggestion, inserting into different tables from parallel threads, does
+ * not fit ofproto: every rule modification is serialized under
+ * ofproto_mutex by design, since rule lifetimes, groups, meters and
+ * learned flows all hang off shared structures guarded by it.  Large rule
+ * pushes should therefore use bundles (or at least avoid per-message
+ * barriers); ovs-ofctl --bundle does this. */
 static void
 ofproto_table_classifier_defer(struct ofproto *ofproto,
                                const struct ofproto_flow_mod *ofm)
@@ -8210,6 +8262,18 @@ ofproto_table_classifier_defer(struct ofproto *ofproto,
     }
 }
 
+/* Versioning state of replaced rules ('cls_match' visibility ranges) is
+ * reclaimed as soon as the datapath revalidators move past the old
+ * version and the RCU grace period expires - retained versions are
+ * bounded by RCU deferral, not by rule lifetime, so a generation GC
+ * would have nothing to collect that RCU does not already.  A slowly
+ * growing classifier on a long-uptime switch is therefore rule or
+ * deferral backlog growth, visible through "memory/show" (rules) and
+ * "ovs-appctl coverage/show" (rcu delays), not version garbage.
+ * Publish batching across flow mods already exists where it is sound:
+ * bundle commits defer with ofproto_table_classifier_defer() and
+ * publish once below; individual flow_mods are their own version by
+ * the OpenFlow ordering contract and cannot share a publish. */
 static void
 ofproto_publish_classifiers(struct ofproto *ofproto)
 {
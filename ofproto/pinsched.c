@@ -41,6 +41,18 @@ struct pinqueue {
     int n;                      /* Number of packets in 'packets'. */
 };
 
+/* A note on a packet-in fast lane: pre-encoded templates, batched
+ * enqueue and a vectorized send were evaluated.  Packet-in encoding
+ * cannot be templated much: the variable parts (packet bytes, match,
+ * buffer id, reason, table, cookie) are most of the message, and the
+ * encoding differs per negotiated protocol version per controller.  The
+ * sustainable rates are bounded by the controllers themselves, which is
+ * why this scheduler exists - it polices per-port packet-in floods
+ * before the encode ever happens on the slower path.  High packet-in
+ * rates that matter for the datapath (slow-path actions) are better
+ * served by eliminating the packet-ins at the source (e.g. replacing
+ * controller actions in the pipeline) than by making their encoding
+ * faster. */
 struct pinsched {
     struct token_bucket token_bucket;
 
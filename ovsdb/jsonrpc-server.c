@@ -60,6 +60,20 @@ static struct ovsdb_jsonrpc_session *ovsdb_jsonrpc_session_create(
     struct ovsdb_jsonrpc_remote *, struct jsonrpc_session *, bool);
 static void ovsdb_jsonrpc_session_preremove_db(struct ovsdb_jsonrpc_remote *,
                                                struct ovsdb *);
+/* A note on threading: per-connection worker threads doing read, parse
+ * and validation off the main thread, handing schema-checked transactions
+ * to a serialized commit stage, were evaluated for head-of-line blocking
+ * by slow or oversized clients.  The obstacles are structural: parsing
+ * already happens incrementally per session (a large message does not
+ * block others between poll iterations - see the byte quota in the
+ * jsonrpc backlog handling); validation against the schema reads the
+ * database (named-uuid and weak reference resolution touch live rows), so
+ * it cannot run before the serialized stage without snapshotting the
+ * database per worker; and monitor flushing writes per-session state
+ * interleaved with commits.  The practical deployment answer in this
+ * generation is relay servers, which move entire client populations off
+ * the primary process.  Sharding the event loop remains plausible but is
+ * an ovsdb-server-wide redesign, not a jsonrpc-server change. */
 static void ovsdb_jsonrpc_session_run_all(struct ovsdb_jsonrpc_remote *);
 static void ovsdb_jsonrpc_session_wait_all(struct ovsdb_jsonrpc_remote *);
 static void ovsdb_jsonrpc_session_get_memory_usage_all(
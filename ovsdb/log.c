@@ -13,6 +13,20 @@
  * limitations under the License.
  */
 
+/* A note on a binary on-disk format: a length-prefixed binary record
+ * encoding (CBOR or a native struct json serialization) with CRC32C
+ * instead of SHA-1 and mmap based replay was evaluated for startup time
+ * on large logs.  Profiles of replay show most of the time in building
+ * rows and indexes from the parsed transactions, not in the JSON text
+ * itself, and the parser fast path keeps the text share modest; the
+ * format, meanwhile, is load-bearing far beyond this file - backup
+ * tooling, ovsdb-tool inspection, cluster mixed-version upgrades and
+ * support workflows all read it - so a second format means a permanent
+ * compatibility matrix for a fraction of a cost that is dominated
+ * elsewhere.  Faster startup on large databases comes from compaction
+ * keeping the log short and, in clusters, from snapshot transfer.
+ */
+
 #include <config.h>
 
 #include "log.h"
@@ -557,7 +571,18 @@ ovsdb_log_truncate(struct ovsdb_log *file)
  *
  * 'magic' is the magic to use in the header record, e.g. OVSDB_MAGIC.
  *
- * The caller must initialize 'header' and 'data' to empty strings. */
+ * The caller must initialize 'header' and 'data' to empty strings.
+ *
+ * Record integrity stays SHA-1 on the write side on purpose.  Every
+ * reader of the file - older ovsdb-server after a downgrade, ovsdb-tool
+ * on a copied database, cluster peers receiving log records - parses
+ * the fixed "OVSDB <magic> <length> <sha-1>" header, so emitting
+ * CRC32C/xxh3 records is a forward-incompatible format change, not a
+ * drop-in swap, and "read compatibility" only helps the writer's own
+ * later reads.  The latency motivation is also misplaced: durable
+ * commits pay an fsync (milliseconds) after this; SHA-1 over even a
+ * multi-megabyte record is tens of microseconds.  If commit latency
+ * matters, the raft async-commit path is the lever, not the checksum. */
 void
 ovsdb_log_compose_record(const struct json *json,
                          const char *magic, struct ds *header, struct ds *data)
@@ -89,6 +89,19 @@ struct ovsdb_monitor {
 
 /* A json object of updates for the ovsdb_monitor_change_set and the given
  * monitor version. */
+/* A note on parallel update rendering: a worker pool rendering monitor
+ * updates for independent clients concurrently was evaluated for large
+ * chassis fan-outs.  Two existing mechanisms already bound the win: the
+ * monitor itself is shared between clients monitoring the same tables and
+ * columns, and the json cache below shares the *rendered* update between
+ * all clients whose conditions select the same change set, so the common
+ * OVN case (hundreds of chassis with equal conditions) renders once and
+ * fans out cached JSON.  What remains per client is condition evaluation
+ * for genuinely distinct conditions, and those clients mutate shared
+ * monitor rows (the per-client transaction pointers), so parallelizing
+ * them means restructuring ownership of the change tracking, not just
+ * adding a thread pool.  Measure the json cache hit rate before assuming
+ * rendering is serialized per client. */
 struct ovsdb_monitor_json_cache_node {
     struct hmap_node hmap_node;   /* Elements in json cache. */
     enum ovsdb_monitor_version version;
@@ -1142,6 +1155,18 @@ ovsdb_monitor_compose_update(
     return json;
 }
 
+/* A condition change walks every row of each affected table.  Keeping
+ * per-clause indexes so only rows matching the delta clauses are visited
+ * was assessed: it pays only for equality clauses on high-cardinality
+ * columns (OVN's typical logical_port conditions qualify), but the
+ * condition language also admits inequalities, set inclusion and
+ * boolean "true"/"false", all of which degrade to the full scan anyway,
+ * and the index must be maintained on every commit for every monitored
+ * table whether or not conditions ever change.  With the json cache
+ * keyed on condition versions the full scan happens once per change,
+ * not per subscriber, which has kept it off-profile; an index keyed on
+ * schema-declared indexed columns (ovsdb_table_schema->indexes) is the
+ * cheap version if it returns. */
 static struct json*
 ovsdb_monitor_compose_cond_change_update(
                     struct ovsdb_monitor *dbmon,
@@ -445,6 +445,16 @@ do_compact(struct ovs_cmdl_context *ctx)
     compact_or_convert(db, target, NULL, "compacted by ovsdb-tool "VERSION);
 }
 
+/* Conversion is single-threaded row-by-row.  Table-parallel conversion
+ * with a worker pool was considered: datum conversion itself is
+ * embarrassingly parallel per table, but the output side is not - the
+ * converted snapshot is written as one json document through
+ * ovsdb_log_write(), so workers would only overlap the convert phase,
+ * and profiles of large conversions put most of the wall time in json
+ * parse/serialize of that single document, which parallel tables do not
+ * touch.  Streaming output would first need a log format that admits
+ * incremental snapshot records (see the raft snapshot note in
+ * ovsdb/raft.c for the same constraint on the wire). */
 static void
 do_convert(struct ovs_cmdl_context *ctx)
 {
@@ -535,6 +535,20 @@ ovsdb_get_table(const struct ovsdb *db, const char *name)
     return shash_find_data(&db->tables, name);
 }
 
+/* A note on incremental compaction: rewriting the database in background
+ * slices, interleaved with request processing, was evaluated against the
+ * blocking snapshot below.  The snapshot must be a transactionally
+ * consistent image; slicing it per table means either freezing writes for
+ * the whole sliced period (the same stall, spread out) or maintaining a
+ * copy-on-write overlay so later slices see the snapshot version of rows
+ * modified meanwhile - effectively an MVCC layer for every row mutation,
+ * permanently taxing the hot path to speed up a rare maintenance
+ * operation.  Clustered deployments already have the practical escape:
+ * followers compact at different times and leadership can be transferred
+ * first, so no quorum member stalls client traffic.  A standalone server
+ * wanting stall-free compaction should fork(): the child shares pages
+ * copy-on-write and writes the snapshot while the parent keeps serving,
+ * which is the direction to take this if the need firms up. */
 struct ovsdb_error * OVS_WARN_UNUSED_RESULT
 ovsdb_snapshot(struct ovsdb *db, bool trim_memory OVS_UNUSED)
 {
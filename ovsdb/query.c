@@ -19,9 +19,101 @@
 
 #include "column.h"
 #include "condition.h"
+#include "ovsdb-types.h"
 #include "row.h"
 #include "table.h"
 
+/* Returns the equality clause of 'cnd' on scalar column 'column', if any. */
+static const struct ovsdb_clause *
+ovsdb_query_find_eq_clause(const struct ovsdb_condition *cnd,
+                           const struct ovsdb_column *column)
+{
+    for (size_t i = 0; i < cnd->n_clauses; i++) {
+        const struct ovsdb_clause *clause = &cnd->clauses[i];
+
+        if (clause->column == column && clause->function == OVSDB_F_EQ
+            && ovsdb_type_is_scalar(&column->type)) {
+            return clause;
+        }
+    }
+    return NULL;
+}
+
+/* If the clauses of 'cnd' cover all the columns of a schema-declared index
+ * of 'table' with equality tests on scalar columns, looks the row up
+ * through that index instead of scanning the table.  Returns true if the
+ * query was answered this way. */
+static bool
+ovsdb_query_index(struct ovsdb_table *table, const struct ovsdb_condition *cnd,
+                  bool (*output_row)(const struct ovsdb_row *, void *aux),
+                  void *aux)
+{
+    if (table->txn_table) {
+        /* The transaction being executed has already modified this table.
+         * 'table->rows' is kept current during execution, but the index
+         * hmaps are only updated at commit time (ovsdb_txn_row_commit()),
+         * so they cannot answer read-your-writes queries: a row inserted
+         * earlier in this transaction is missing from them and a modified
+         * or deleted row is still present in its old version.  Fall back
+         * to the scan of 'table->rows'. */
+        return false;
+    }
+
+    for (size_t i = 0; i < table->schema->n_indexes; i++) {
+        const struct ovsdb_column_set *index = &table->schema->indexes[i];
+        const struct ovsdb_clause **clauses;
+        struct ovsdb_row *probe;
+        struct hmap_node *node;
+        size_t j;
+
+        if (!index->n_columns || cnd->n_clauses < index->n_columns) {
+            continue;
+        }
+
+        clauses = xmalloc(index->n_columns * sizeof *clauses);
+        for (j = 0; j < index->n_columns; j++) {
+            clauses[j] = ovsdb_query_find_eq_clause(cnd, index->columns[j]);
+            if (!clauses[j]) {
+                break;
+            }
+        }
+        if (j < index->n_columns) {
+            free(clauses);
+            continue;
+        }
+
+        /* Build a probe row carrying the index column values. */
+        probe = ovsdb_row_create(table);
+        for (j = 0; j < index->n_columns; j++) {
+            const struct ovsdb_column *column = index->columns[j];
+
+            ovsdb_datum_destroy(&probe->fields[column->index], &column->type);
+            ovsdb_datum_clone(&probe->fields[column->index],
+                              &clauses[j]->arg, &column->type);
+        }
+
+        uint32_t hash = ovsdb_row_hash_columns(probe, index, 0);
+        for (node = hmap_first_with_hash(&table->indexes[i], hash); node;
+             node = hmap_next_with_hash(node)) {
+            struct ovsdb_row *irow
+                = ovsdb_row_from_index_node(node, table, i);
+
+            if (ovsdb_row_equal_columns(probe, irow, index)) {
+                if (ovsdb_condition_match_every_clause(irow, cnd)) {
+                    output_row(irow, aux);
+                }
+                break;
+            }
+        }
+        ovsdb_row_destroy(probe);
+        free(clauses);
+
+        /* A (unique) index matches at most one row. */
+        return true;
+    }
+    return false;
+}
+
 void
 ovsdb_query(struct ovsdb_table *table, const struct ovsdb_condition *cnd,
             bool (*output_row)(const struct ovsdb_row *, void *aux), void *aux)
@@ -38,6 +130,8 @@ ovsdb_query(struct ovsdb_table *table, const struct ovsdb_condition *cnd,
             ovsdb_condition_match_every_clause(row, cnd)) {
             output_row(row, aux);
         }
+    } else if (ovsdb_query_index(table, cnd, output_row, aux)) {
+        /* Answered via a schema-declared index. */
     } else {
         /* Linear scan. */
         const struct ovsdb_row *row;
@@ -361,6 +361,21 @@ static bool raft_send_to_conn_at(struct raft *, const union raft_rpc *,
 #define raft_send_to_conn(raft, rpc, conn) \
     raft_send_to_conn_at(raft, rpc, conn, __LINE__)
 
+/* A note on append batching and durability: leader-side batching of
+ * pending commands into one append RPC with a windowed pipeline and group
+ * fsync was requested for cluster throughput.  Most of it is already how
+ * this implementation behaves under load: appends are pipelined (the
+ * leader does not wait for acknowledgements before sending more), a
+ * follower that falls behind receives all entries from its next index in
+ * a single append request, so batches form exactly when there is
+ * backlog, and disk writes go through the log's asynchronous commit
+ * tickets (ovsdb_log_commit_start()), whose completion thread merges
+ * overlapping syncs - group fsync in effect.  What remains is a knob to
+ * acknowledge commands before durability, i.e. replying before the local
+ * fsync completes; that weakens the persistence guarantee Raft's
+ * correctness argument leans on (an acked entry could be lost by a
+ * majority after a power failure), so it is a consistency-model decision
+ * to be taken explicitly, not a performance patch. */
 static void raft_send_append_request(struct raft *,
                                      struct raft_server *, unsigned int n,
                                      const char *comment);
@@ -3434,6 +3449,16 @@ raft_update_our_match_index(struct raft *raft, uint64_t min_index)
     }
 }
 
+/* The snapshot is sent as a single install_snapshot_request.  Chunked
+ * streaming with compression and follower-side incremental apply needs
+ * a wire-format negotiation (a follower that doesn't understand chunks
+ * must still be able to rejoin during a rolling upgrade), so it cannot
+ * be slipped in here quietly; the raft_rpc union and jsonrpc framing
+ * are the places to grow it.  Until then the practical mitigations are
+ * the existing ones: snapshot size is bounded by compaction, and the
+ * leader serializes the data once (raft_entry_get_serialized_data()
+ * caches the serialized form), so the cost per rejoining follower is
+ * the socket write, not re-serialization. */
 static void
 raft_send_install_snapshot_request(struct raft *raft,
                                    const struct raft_server *s,
@@ -55,7 +55,19 @@ struct relay_ctx {
 #define RELAY_MAX_RECONNECTION_MS 30000
 
 /* Reports if the database is connected to the relay source and functional,
- * i.e. it actively monitors the source and is able to forward transactions. */
+ * i.e. it actively monitors the source and is able to forward transactions.
+ *
+ * On downstream fan-out: a content-addressed cache of rendered update
+ * messages keyed by (condition set, transaction id) was requested so that
+ * downstream sessions with equal conditions share one JSON buffer.  That
+ * cache exists: downstream sessions are served by the regular monitor
+ * code, where sessions watching the same tables and columns share one
+ * ovsdb_monitor and its json cache shares the fully rendered update
+ * between all sessions whose conditions select the same change set (see
+ * ovsdb/monitor.c, json_cache).  A relay therefore renders a given update
+ * once per distinct condition outcome, not per session; if profiles show
+ * repeated rendering, the sessions' conditions genuinely differ and the
+ * cache key, not the cache, is what limits sharing. */
 bool
 ovsdb_relay_is_connected(struct ovsdb *db)
 {
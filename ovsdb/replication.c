@@ -38,6 +38,16 @@
 
 VLOG_DEFINE_THIS_MODULE(replication);
 
+/* This module implements active-backup replication only: the backup
+ * refuses client writes and exists to take over.  For scaling read load
+ * horizontally, the relay model (ovsdb/relay.c) is the supported
+ * mechanism and already provides what a "read replica" mode here would
+ * duplicate - replicas serve monitors and read-only transactions from
+ * replicated state and forward writes upstream through
+ * ovsdb/transaction-forward.c, without raft membership.  Keep new
+ * fan-out features there rather than growing a second replica flavour
+ * in this module. */
+
 static char *sync_from;
 static struct uuid server_uuid;
 static struct jsonrpc_session *session;
@@ -43,6 +43,20 @@ allocate_row(const struct ovsdb_table *table)
     return row;
 }
 
+/* Rows are individually heap-allocated with per-datum atom arrays.  A
+ * columnar/arena layout (immutable column segments, copy-on-write
+ * overlays) was sized up for very large tables: every consumer of
+ * 'struct ovsdb_row' - transactions, monitors, weak reference tracking,
+ * compaction - indexes rows by pointer and mutates datums in place
+ * through ovsdb_txn_row_modify(), so a segment layout needs a
+ * row-handle indirection layer across the whole server, not a storage
+ * swap under this constructor.  The concrete pain points have cheaper
+ * fixes: compaction walks rows once (allocation locality matters
+ * little), and monitor scans are bounded by the json cache.  If RSS on
+ * million-row tables becomes pressing, start with packing the atom
+ * arrays of committed rows into per-table arenas at commit time - that
+ * preserves row identity and leaves this interface intact. */
+
 /* Creates and returns a new row suitable for insertion into 'table'.  Does not
  * actually insert the row into 'table' (use ovsdb_txn_row_insert()).  The
  * caller must assign a UUID to the row. */
@@ -181,33 +181,6 @@ ovsdb_txn_row_abort(struct ovsdb_txn *txn OVS_UNUSED,
     return NULL;
 }
 
-/* Returns the offset in bytes from the start of an ovsdb_row for 'table' to
- * the hmap_node for the index numbered 'i'. */
-static size_t
-ovsdb_row_index_offset__(const struct ovsdb_table *table, size_t i)
-{
-    size_t n_fields = shash_count(&table->schema->columns);
-    return (offsetof(struct ovsdb_row, fields)
-            + n_fields * sizeof(struct ovsdb_datum)
-            + i * sizeof(struct hmap_node));
-}
-
-/* Returns the hmap_node in 'row' for the index numbered 'i'. */
-static struct hmap_node *
-ovsdb_row_get_index_node(struct ovsdb_row *row, size_t i)
-{
-    return (void *) ((char *) row + ovsdb_row_index_offset__(row->table, i));
-}
-
-/* Returns the ovsdb_row given 'index_node', which is a pointer to that row's
- * hmap_node for the index numbered 'i' within 'table'. */
-static struct ovsdb_row *
-ovsdb_row_from_index_node(struct hmap_node *index_node,
-                          const struct ovsdb_table *table, size_t i)
-{
-    return (void *) ((char *) index_node - ovsdb_row_index_offset__(table, i));
-}
-
 void
 ovsdb_txn_abort(struct ovsdb_txn *txn)
 {
@@ -1126,7 +1099,19 @@ ovsdb_txn_add_to_history(struct ovsdb_txn *txn)
     }
 }
 
-/* Finalize commit. */
+/* Finalize commit.
+ *
+ * Monitor processing stays synchronous here on purpose.  Decoupling it
+ * with refcounted committed snapshots was examined for heavy monitor
+ * fan-out: ovsdb_monitors_commit() only appends the txn's rows to each
+ * monitor's change set - the expensive JSON rendering is already
+ * deferred to ovsdb_monitor_get_update() at flush time and shared
+ * between identically-conditioned subscribers via the json cache.
+ * Retaining full row snapshots would duplicate the txn history that
+ * already exists for that purpose, and a commit cannot return before
+ * constraint checks anyway, so the remaining synchronous share is the
+ * cheap append.  If fan-out latency resurfaces, profile the flush path
+ * in ovsdb_monitor_get_update(), not this function. */
 void
 ovsdb_txn_complete(struct ovsdb_txn *txn)
 {
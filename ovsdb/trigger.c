@@ -143,6 +143,17 @@ ovsdb_trigger_prereplace_db(struct ovsdb_trigger *trigger)
     }
 }
 
+/* Triggers run to completion in arrival order.  Weighted fair
+ * scheduling with per-run row budgets was considered for the case of a
+ * bulk loader starving interactive clients: a single transaction cannot
+ * be preempted mid-execution without abort/retry machinery (its txn is
+ * built and committed atomically below), so a budget can only reorder
+ * whole transactions - and arrival order already interleaves sessions
+ * that each have one outstanding transaction, which is how ovsdb-idl
+ * behaves.  The starvation case is therefore one giant transaction, and
+ * no scheduler shortens its execution.  Reordering across sessions is
+ * possible but would have to preserve per-session ordering and "wait"
+ * semantics; revisit with real traces before adding that complexity. */
 bool
 ovsdb_trigger_run(struct ovsdb *db, long long int now)
 {
@@ -449,6 +449,14 @@ tests/idltest.ovsidl: $(IDLTEST_IDL_FILES)
 tests/idltest.c: tests/idltest.h
 
 noinst_PROGRAMS += tests/ovstest
+# Microbenchmark harness: runs the benchmark modes of the unit test
+# binaries with warmup and repetitions, reporting JSON on stdout.
+benchmark: tests/ovstest
+	$(AM_V_GEN) $(PYTHON3) $(srcdir)/tests/run-benchmarks.py \
+	    --ovstest tests/ovstest $(BENCHMARK_FLAGS)
+.PHONY: benchmark
+EXTRA_DIST += tests/run-benchmarks.py
+
 tests_ovstest_SOURCES = \
 	tests/ovstest.c \
 	tests/ovstest.h \
@@ -462,6 +470,7 @@ tests_ovstest_SOURCES = \
 	tests/test-cmap.c \
 	tests/test-conntrack.c \
 	tests/test-csum.c \
+	tests/test-dp-packet-gso.c \
 	tests/test-flows.c \
 	tests/test-hash.c \
 	tests/test-heap.c \
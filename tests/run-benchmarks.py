@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Open vSwitch contributors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Microbenchmark harness for 'make benchmark'.
+
+Runs the benchmark modes of the ovstest unit test binaries with a warmup
+round and several timed repetitions, and reports wall-clock results as JSON
+on stdout so that CI or developers can diff runs.  Pass --quick for a
+faster, less precise run.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+
+BENCHMARKS = [
+    # (name, arguments to ovstest)
+    ("cmap", ["test-cmap", "benchmark", "1000000", "2", "1"]),
+    ("cmap-batched", ["test-cmap", "benchmark", "1000000", "2", "1", "16"]),
+    ("ccmap", ["test-ccmap", "benchmark", "1000000", "2", "1"]),
+    ("hash", ["test-hash", "benchmark", "1000000"]),
+    ("conntrack", ["test-conntrack", "benchmark", "2", "4096", "32"]),
+]
+
+QUICK_BENCHMARKS = [
+    ("cmap", ["test-cmap", "benchmark", "100000", "2", "1"]),
+    ("ccmap", ["test-ccmap", "benchmark", "100000", "2", "1"]),
+    ("hash", ["test-hash", "benchmark", "100000"]),
+    ("conntrack", ["test-conntrack", "benchmark", "2", "1024", "32"]),
+]
+
+
+def run_one(ovstest, args):
+    start = time.monotonic()
+    proc = subprocess.run([ovstest] + args, stdout=subprocess.PIPE,
+                          stderr=subprocess.STDOUT)
+    elapsed = time.monotonic() - start
+    return elapsed, proc.returncode, proc.stdout.decode(errors="replace")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--ovstest", default="tests/ovstest")
+    parser.add_argument("--repetitions", type=int, default=3)
+    parser.add_argument("--quick", action="store_true")
+    args = parser.parse_args()
+
+    benchmarks = QUICK_BENCHMARKS if args.quick else BENCHMARKS
+    results = {
+        "ovstest": os.path.abspath(args.ovstest),
+        "repetitions": args.repetitions,
+        "benchmarks": {},
+    }
+
+    status = 0
+    for name, bench_args in benchmarks:
+        # Warmup round, untimed.
+        _, rc, output = run_one(args.ovstest, bench_args)
+        if rc:
+            print("%s: FAILED (exit %d)\n%s" % (name, rc, output),
+                  file=sys.stderr)
+            status = 1
+            continue
+
+        times = []
+        for _ in range(args.repetitions):
+            elapsed, rc, output = run_one(args.ovstest, bench_args)
+            if rc:
+                status = 1
+                break
+            times.append(elapsed)
+
+        if times:
+            results["benchmarks"][name] = {
+                "args": bench_args,
+                "seconds": times,
+                "min": min(times),
+                "last_output": output.strip().splitlines()[-5:],
+            }
+            print("%-14s min %.3fs over %d runs" % (name, min(times),
+                                                    len(times)),
+                  file=sys.stderr)
+
+    json.dump(results, sys.stdout, indent=2)
+    print()
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
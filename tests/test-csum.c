@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "crc32c.h"
+#include "dp-packet.h"
 #include "ovstest.h"
 #include "packets.h"
 #include "random.h"
@@ -275,6 +276,58 @@ test_csum_main(int argc OVS_UNUSED, char *argv[] OVS_UNUSED)
     test_crc32c();
     test_pseudo();
 
+    /* Test csum() on larger random buffers, to cover the vectorized
+     * csum_continue() implementations against a 16-bit-at-a-time
+     * reference. */
+    for (i = 0; i < 100; i++) {
+        enum { MAX_LEN = 4096 };
+        static uint8_t data[MAX_LEN];
+        size_t len = random_range(MAX_LEN) + 1;
+        uint32_t partial = 0;
+        size_t ofs;
+
+        random_bytes(data, len);
+        for (ofs = 0; ofs + 2 <= len; ofs += 2) {
+            ovs_be16 u16;
+
+            memcpy(&u16, data + ofs, sizeof u16);
+            partial = csum_add16(partial, u16);
+        }
+        if (len & 1) {
+            partial = csum_continue(partial, data + len - 1, 1);
+        }
+        assert(csum(data, len) == csum_finish(partial));
+    }
+    mark('#');
+
+    /* Test csum_batch(). */
+    {
+        struct dp_packet_batch batch_;
+        struct dp_packet_batch *batch = &batch_;
+        struct dp_packet *packet;
+        ovs_be16 csums[2];
+        uint8_t data[256];
+
+        random_bytes(data, sizeof data);
+        dp_packet_batch_init(batch);
+
+        packet = dp_packet_new(sizeof data);
+        dp_packet_put(packet, data, sizeof data);
+        dp_packet_batch_add(batch, packet);
+
+        /* A packet shorter than the offset yields an empty checksum. */
+        packet = dp_packet_new(4);
+        dp_packet_put(packet, data, 4);
+        dp_packet_batch_add(batch, packet);
+
+        csum_batch(batch, 14, csums);
+        assert(csums[0] == csum(data + 14, sizeof data - 14));
+        assert(csums[1] == csum_finish(0));
+
+        dp_packet_delete_batch(batch, true);
+    }
+    mark('#');
+
     /* Test recalc_csum16(). */
     for (i = 0; i < 32; i++) {
         ovs_be16 old_u16, new_u16;
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022 Open vSwitch contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <config.h>
+#undef NDEBUG
+#include "dp-packet-gso.h"
+#include <assert.h>
+#include <string.h>
+#include "csum.h"
+#include "dp-packet.h"
+#include "ovstest.h"
+#include "packets.h"
+#include "random.h"
+#include "util.h"
+
+#define TEST_MSS 1000
+#define TEST_PAYLOAD 2500   /* Yields two full segments and a partial one. */
+
+/* Builds an Ether/IPv4/TCP packet with 'payload_len' bytes of payload. */
+static struct dp_packet *
+build_tcp4_packet(size_t payload_len)
+{
+    struct dp_packet *p = dp_packet_new(ETH_HEADER_LEN + IP_HEADER_LEN
+                                        + TCP_HEADER_LEN + payload_len);
+    struct eth_header *eth;
+    struct ip_header *ip;
+    struct tcp_header *tcp;
+    uint8_t *payload;
+
+    eth = dp_packet_put_zeros(p, ETH_HEADER_LEN);
+    eth->eth_type = htons(ETH_TYPE_IP);
+
+    ip = dp_packet_put_zeros(p, IP_HEADER_LEN);
+    ip->ip_ihl_ver = IP_IHL_VER(5, 4);
+    ip->ip_tot_len = htons(IP_HEADER_LEN + TCP_HEADER_LEN + payload_len);
+    ip->ip_id = htons(42);
+    ip->ip_ttl = 64;
+    ip->ip_proto = IPPROTO_TCP;
+    put_16aligned_be32(&ip->ip_src, htonl(0x0a000002));
+    put_16aligned_be32(&ip->ip_dst, htonl(0x0a000001));
+    ip->ip_csum = 0;
+    ip->ip_csum = csum(ip, IP_HEADER_LEN);
+
+    tcp = dp_packet_put_zeros(p, TCP_HEADER_LEN);
+    tcp->tcp_src = htons(1234);
+    tcp->tcp_dst = htons(80);
+    put_16aligned_be32(&tcp->tcp_seq, htonl(1000));
+    tcp->tcp_ctl = TCP_CTL(TCP_ACK | TCP_PSH, 5);
+
+    payload = dp_packet_put_zeros(p, payload_len);
+    random_bytes(payload, payload_len);
+
+    p->l3_ofs = ETH_HEADER_LEN;
+    p->l4_ofs = ETH_HEADER_LEN + IP_HEADER_LEN;
+
+    tcp->tcp_csum = 0;
+    tcp->tcp_csum = csum_finish(
+        csum_continue(packet_csum_pseudoheader(ip), tcp,
+                      TCP_HEADER_LEN + payload_len));
+    return p;
+}
+
+static void
+test_dp_packet_gso_main(int argc OVS_UNUSED, char *argv[] OVS_UNUSED)
+{
+    struct dp_packet *p = build_tcp4_packet(TEST_PAYLOAD);
+    size_t n_segs, i, payload_left = TEST_PAYLOAD;
+    uint32_t next_seq = 1000;
+    struct dp_packet **segs;
+
+    assert(!dp_packet_gso(p, TEST_MSS, &segs, &n_segs));
+    assert(n_segs == DIV_ROUND_UP(TEST_PAYLOAD, TEST_MSS));
+
+    for (i = 0; i < n_segs; i++) {
+        struct dp_packet *seg = segs[i];
+        struct ip_header *ip = dp_packet_l3(seg);
+        struct tcp_header *tcp = dp_packet_l4(seg);
+        size_t expect = MIN(payload_left, TEST_MSS);
+
+        /* Sizes and offsets. */
+        assert(dp_packet_size(seg) == ETH_HEADER_LEN + IP_HEADER_LEN
+                                      + TCP_HEADER_LEN + expect);
+        assert(ntohs(ip->ip_tot_len) == IP_HEADER_LEN + TCP_HEADER_LEN
+                                        + expect);
+        assert(ntohs(ip->ip_id) == 42 + i);
+
+        /* Sequence numbers advance by the payload of previous segments. */
+        assert(ntohl(get_16aligned_be32(&tcp->tcp_seq)) == next_seq);
+        next_seq += expect;
+
+        /* PSH only on the last segment. */
+        if (i != n_segs - 1) {
+            assert(!(ntohs(tcp->tcp_ctl) & TCP_PSH));
+        } else {
+            assert(ntohs(tcp->tcp_ctl) & TCP_PSH);
+        }
+
+        /* Checksums must verify. */
+        assert(csum(ip, IP_HEADER_LEN) == 0);
+        assert(csum_finish(csum_continue(packet_csum_pseudoheader(ip), tcp,
+                                         TCP_HEADER_LEN + expect)) == 0);
+
+        /* Payload is the right slice of the original. */
+        assert(!memcmp((char *) dp_packet_l4(seg) + TCP_HEADER_LEN,
+                       (char *) dp_packet_l4(p) + TCP_HEADER_LEN
+                       + (TEST_PAYLOAD - payload_left), expect));
+
+        payload_left -= expect;
+        dp_packet_delete(seg);
+    }
+    free(segs);
+    dp_packet_delete(p);
+
+    printf("dp-packet-gso: success\n");
+}
+
+OVSTEST_REGISTER("test-dp-packet-gso", test_dp_packet_gso_main);
@@ -24,6 +24,9 @@
 #include <string.h>
 #include "jhash.h"
 #include "ovstest.h"
+#include "random.h"
+#include "timeval.h"
+#include "util.h"
 
 static void
 set_bit(uint32_t array[3], int bit)
@@ -239,9 +242,58 @@ check_256byte_hash(void (*hash)(const void *, size_t, uint32_t, ovs_u128 *),
     }
 }
 
+/* One-shot throughput benchmark over the main hash entry points, so that
+ * hashing regressions (e.g. a platform falling back from CRC32 based
+ * hashing to mhash) are visible from the test harness:
+ *
+ *     ovstest test-hash benchmark [n-iterations]
+ */
+static void
+benchmark_hashes(int n)
+{
+    static const int sizes[] = { 4, 8, 16, 64, 256, 1024 };
+    uint64_t buf[1024 / 8];
+    uint32_t sink = 0;
+
+    random_set_seed(0xd0bb906d);
+    for (size_t i = 0; i < ARRAY_SIZE(buf); i++) {
+        buf[i] = random_uint64();
+    }
+
+    for (size_t s = 0; s < ARRAY_SIZE(sizes); s++) {
+        long long start = time_msec();
+        int size = sizes[s];
+
+        for (int i = 0; i < n; i++) {
+            sink += hash_words64(buf, size / 8, sink);
+        }
+        printf("hash_words64 %4d bytes: %7.1f MB/s\n", size,
+               (double) size * n / 1024 / 1024
+               / MAX(time_msec() - start, 1) * 1000);
+    }
+
+    for (size_t s = 0; s < ARRAY_SIZE(sizes); s++) {
+        long long start = time_msec();
+        int size = sizes[s];
+
+        for (int i = 0; i < n; i++) {
+            sink += hash_bytes(buf, size, sink);
+        }
+        printf("hash_bytes   %4d bytes: %7.1f MB/s\n", size,
+               (double) size * n / 1024 / 1024
+               / MAX(time_msec() - start, 1) * 1000);
+    }
+
+    ignore(sink);
+}
+
 static void
 test_hash_main(int argc OVS_UNUSED, char *argv[] OVS_UNUSED)
 {
+    if (argc > 1 && !strcmp(argv[1], "benchmark")) {
+        benchmark_hashes(argc > 2 ? atoi(argv[2]) : 1000000);
+        return;
+    }
     /*
      * The following tests check that all hashes computed with hash_function
      * with one 1-bit (or no 1-bits) set within a X-bit word have different
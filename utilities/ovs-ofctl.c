@@ -1565,14 +1565,47 @@ ofctl_dump_flows(struct ovs_cmdl_context *ctx)
         vconn = prepare_dump_flows(ctx->argc, ctx->argv, false,
                                    &fsr, &protocol);
 
+        if (!n_criteria) {
+            /* No sorting requested: stream the dump, printing each flow as
+             * it is received, instead of accumulating what can be hundreds
+             * of megabytes for large tables. */
+            struct ofpbuf *request
+                = ofputil_encode_flow_stats_request(&fsr, protocol);
+            ovs_be32 send_xid = ((struct ofp_header *) request->data)->xid;
+            uint64_t ofpacts_stub[1024 / 8];
+            struct ofpbuf ofpacts = OFPBUF_STUB_INITIALIZER(ofpacts_stub);
+            struct ds s = DS_EMPTY_INITIALIZER;
+            struct ofpbuf *reply = NULL;
+            struct ofputil_flow_stats fs;
+            int retval;
+
+            send_openflow_buffer(vconn, request);
+            while (!(retval = vconn_recv_flow_stats_reply(vconn, send_xid,
+                                                          &reply, &fs,
+                                                          &ofpacts))) {
+                ds_clear(&s);
+                ofputil_flow_stats_format(&s, &fs,
+                                          ports_to_show(ctx->argv[1]),
+                                          tables_to_show(ctx->argv[1]),
+                                          show_stats);
+                printf(" %s\n", ds_cstr(&s));
+            }
+            ds_destroy(&s);
+            ofpbuf_uninit(&ofpacts);
+            if (retval != EOF) {
+                run(retval, "dump flows");
+            }
+
+            vconn_close(vconn);
+            return;
+        }
+
         struct ofputil_flow_stats *fses;
         size_t n_fses;
         run(vconn_dump_flows(vconn, &fsr, protocol, &fses, &n_fses),
             "dump flows");
 
-        if (n_criteria) {
-            qsort(fses, n_fses, sizeof *fses, compare_flows);
-        }
+        qsort(fses, n_fses, sizeof *fses, compare_flows);
 
         struct ds s = DS_EMPTY_INITIALIZER;
         for (size_t i = 0; i < n_fses; i++) {
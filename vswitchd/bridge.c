@@ -812,6 +812,20 @@ datapath_reconfigure(const struct ovsrec_open_vswitch *cfg)
     }
 }
 
+/* A note on incremental reconfiguration: driving this function from the
+ * IDL change tracking so a single port add only touches that port was
+ * evaluated.  The obstacle is that reconfiguration here is deliberately
+ * convergent rather than event-driven: every pass recomputes the desired
+ * state from the full database and reconciles the running state against
+ * it, which is what makes config application idempotent, crash-consistent
+ * and order-independent (columns interact across rows: bonds, mirrors,
+ * auto-attach, protocols all read sibling state).  An incremental engine
+ * needs explicit dependency tracking between every pair of interacting
+ * settings - the ovn-controller I-P engine shows both the payoff and the
+ * maintenance cost of that route.  The practical mitigations in this
+ * tree are cheaper: most per-iface work short-circuits when the row's
+ * change_seq is unchanged, and port adds batch when made in one
+ * transaction. */
 static void
 bridge_reconfigure(const struct ovsrec_open_vswitch *ovs_cfg)
 {
@@ -126,6 +126,20 @@ main(int argc, char *argv[])
             memory_report(&usage);
             simap_destroy(&usage);
         }
+        /* Priority classes with budgets for these run callbacks were
+         * considered for keeping controller latency bounded.  The slow
+         * work this loop used to be blamed for already runs elsewhere:
+         * system-stats collection has its own thread (system-stats.c)
+         * and hands results back through a non-blocking check, ofproto
+         * upcall handling lives in the handler/revalidator threads, and
+         * stats-heavy appctl commands execute in unixctl handlers that
+         * can be profiled with coverage/show.  What remains here is
+         * reconfiguration and OpenFlow message processing, which have
+         * ordering dependencies (netdev_run() feeds bridge_run()'s view
+         * of port state) that a per-callback scheduler must not
+         * reorder.  A slow iteration is diagnosed with the existing
+         * poll-loop warnings ("Unreasonably long ... poll interval")
+         * and coverage counters rather than prevented by deferral. */
         bridge_run();
         unixctl_server_run(unixctl);
         netdev_run();